@@ -1,6 +1,8 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
 
+#include <cstddef>
+
 enum Cell { DEAD = 0, ALIVE = 1 };
 
 enum BoardInitType {
@@ -24,15 +26,23 @@ public:
 
     [[nodiscard]] int getHeight() const;
 
+    // Number of cells, may exceed the int range
+    [[nodiscard]] size_t getSize() const;
+
     [[nodiscard]] Cell *getBoard() const;
 
     // Mutators
     void setCell(int x, int y, Cell value);
 
+    // new_board must be allocated with allocateBoardMemory
     void setBoard(Cell *new_board);
 
     void Init(BoardInitType type);
 
+    // Inits the board as rows [first_row, first_row + height) of a board
+    // with board_height rows
+    void Init(BoardInitType type, int first_row, int board_height);
+
     void updateRow(
         const Cell *prevRow,
         const Cell *currRow,
@@ -42,6 +52,9 @@ public:
 
     void updateBoard(const Cell *upperGhostRow, const Cell *lowerGhostRow);
 
+    // Updates rows [from, to) without touching the edge rows
+    void updateBoardRows(int from, int to);
+
     void updateBoardWithoutEdges();
 
     void updateBoardEdges(
@@ -55,6 +68,9 @@ public:
     createSubBoard(const Board &board, int start_row, int rows_number);
 
 private:
+    // Offset of row y, computed in 64 bits
+    [[nodiscard]] size_t offset(int y) const;
+
     int width;
     int height;
     alignas(64) Cell *board;
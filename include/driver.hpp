@@ -0,0 +1,13 @@
+#ifndef DRIVER_HPP
+#define DRIVER_HPP
+
+#include "../include/utils.hpp"
+
+// Runs the whole simulation: parses command-line arguments on top of the
+// given defaults, splits the board into row strips between the working
+// processes, steps them with the selected engine and exchange strategy and
+// collects snapshots in verbose mode. With more than one process in verbose
+// mode the last process only collects snapshots. Returns the exit code.
+int runSolution(int argc, char *argv[], Args args);
+
+#endif  // DRIVER_HPP
@@ -0,0 +1,321 @@
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../include/board.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/utils.hpp"
+
+// Stepping backend working on a strip of rows. Edge rows are exchanged as
+// Cell rows no matter how the engine stores the board, ghost rows set to
+// nullptr are treated as dead.
+class Engine {
+public:
+    Engine(int width, int height);
+
+    virtual ~Engine() = default;
+
+    // Accessors
+    [[nodiscard]] int getWidth() const;
+
+    [[nodiscard]] int getHeight() const;
+
+    // Copies a single row, used for edge rows exchange
+    virtual void copyRow(int y, Cell *out) const = 0;
+
+    // Copies the whole strip, used for snapshots
+    virtual void copyBoard(Cell *out) const = 0;
+
+    // Prints NUMA placement of the rows updated by every OpenMP thread
+    virtual void printNumaReport(int proc_id) const = 0;
+
+    // hashCells of the strip row by row, first_index is the board index of
+    // its first cell
+    [[nodiscard]] virtual uint64_t hashBoard(size_t first_index) const;
+
+    // Mutators
+    virtual void updateBoard(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    );
+
+    // Updates rows [from, to) into the next generation, edge rows need the
+    // ghost rows so 0 < from and to < height
+    virtual void updateBoardRows(int from, int to) = 0;
+
+    virtual void updateBoardWithoutEdges();
+
+    virtual void updateBoardEdges(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) = 0;
+
+    // Updates the whole strip while the ghost rows are in flight.
+    // receive_ghost_rows(wait) returns whether they arrived and were written
+    // to the given rows, waiting for them if wait is set. It is called on the
+    // calling thread only, until it returns true. Engines may start the edge
+    // rows as soon as the ghost rows arrive, before the interior is done.
+    virtual void updateBoardOverlapped(
+        const std::function<bool(bool)> &receive_ghost_rows,
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    );
+
+    // Advances the strip by several generations with dead ghost rows
+    virtual void advance(int generations);
+
+protected:
+    int width;
+    int height;
+};
+
+// Board::updateRow on Cell rows
+class ScalarEngine : public Engine {
+public:
+    ScalarEngine(const Board &board, int start_row, int rows_number);
+
+    void copyRow(int y, Cell *out) const override;
+
+    void copyBoard(Cell *out) const override;
+
+    void printNumaReport(int proc_id) const override;
+
+    void updateBoard(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+    void updateBoardRows(int from, int to) override;
+
+    void updateBoardEdges(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+private:
+    Board board;
+};
+
+// One byte per cell with a dead border around the strip, so the neighbor
+// count has no branches and vectorizes
+class VectorizedEngine : public Engine {
+public:
+    VectorizedEngine(const Board &board, int start_row, int rows_number);
+
+    ~VectorizedEngine() override;
+
+    void copyRow(int y, Cell *out) const override;
+
+    void copyBoard(Cell *out) const override;
+
+    void printNumaReport(int proc_id) const override;
+
+    void updateBoardRows(int from, int to) override;
+
+    void updateBoardEdges(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+protected:
+    // Sets the sizes only, board and new_board are left to the derived engine
+    VectorizedEngine(int width, int height);
+
+    // Row y of the given buffer, rows -1 and height are the ghost rows
+    [[nodiscard]] uint8_t *getRow(uint8_t *buffer, int y) const;
+
+    // Updates rows [from, to) from board to new_board
+    virtual void updateRows(int from, int to);
+
+    // Fills the ghost rows of board
+    void setGhostRows(const Cell *upperGhostRow, const Cell *lowerGhostRow);
+
+    // Called after the ghost rows of board were filled
+    virtual void onGhostRowsSet() {}
+
+    static void updateRow(
+        const uint8_t *prevRow,
+        const uint8_t *currRow,
+        const uint8_t *nextRow,
+        uint8_t *newRow,
+        int width
+    );
+
+    int stride;
+    // Rows of the strip and both ghost rows
+    size_t buffer_size;
+    uint8_t *board;
+    uint8_t *new_board;
+};
+
+// Byte kernel that skips rows whose whole neighborhood is dead
+class SparseEngine : public VectorizedEngine {
+public:
+    SparseEngine(const Board &board, int start_row, int rows_number);
+
+    void updateBoardEdges(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+protected:
+    void updateRows(int from, int to) override;
+
+    void onGhostRowsSet() override;
+
+private:
+    // Whether row y (shifted by the upper ghost row) has any alive cell, one
+    // vector per buffer
+    std::vector<uint8_t> alive_rows;
+    std::vector<uint8_t> new_alive_rows;
+};
+
+// Byte kernel on tiles of the strip executed by a work-stealing scheduler.
+// Over several generations without ghost rows a tile starts generation g + 1
+// as soon as its neighbors finish generation g, with no barrier in between.
+class TiledEngine : public VectorizedEngine {
+public:
+    TiledEngine(const Board &board, int start_row, int rows_number);
+
+    // Interior tiles run on the scheduler. Between its tiles the calling
+    // thread polls for the ghost rows and spawns the edge rows once they
+    // arrived, so they do not wait for the whole interior.
+    void updateBoardOverlapped(
+        const std::function<bool(bool)> &receive_ghost_rows,
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+    void advance(int generations) override;
+
+protected:
+    void updateRows(int from, int to) override;
+
+private:
+    static constexpr int tile_rows = 32;
+    static constexpr int tile_columns = 1024;
+
+    // Updates rows [from, to) and columns [first_column, last_column) of the
+    // tile from source to destination
+    void updateTile(
+        uint8_t *source,
+        uint8_t *destination,
+        int from,
+        int to,
+        int first_column,
+        int last_column
+    ) const;
+
+    int tile_rows_count;
+    int tile_columns_count;
+    // Tiles sharing an edge or a corner, including the tile itself
+    std::vector<std::vector<int>> neighbor_tiles;
+    WorkStealingScheduler scheduler;
+};
+
+// Default size of a band buffer of the out-of-core engine
+#ifndef OUT_OF_CORE_BAND_BYTES
+#define OUT_OF_CORE_BAND_BYTES (64 << 20)
+#endif
+
+// Byte kernel on a board kept in memory-mapped scratch files instead of RAM,
+// for single process runs on boards larger than the memory. Over several
+// generations the board is streamed through a buffer band by band, each band
+// is loaded with `generations` extra rows on both sides, advanced in memory
+// and written back, so a pass over the files covers up to
+// max_pass_generations generations.
+class OutOfCoreEngine : public VectorizedEngine {
+public:
+    // Creates both files in the directory, they are unlinked right away and
+    // disappear with the engine. The board is initialized band by band. Rows
+    // per band are chosen so a band buffer takes about band_bytes bytes.
+    OutOfCoreEngine(
+        const std::string &directory,
+        int width,
+        int height,
+        BoardInitType type,
+        size_t band_bytes = OUT_OF_CORE_BAND_BYTES
+    );
+
+    ~OutOfCoreEngine() override;
+
+    void advance(int generations) override;
+
+private:
+    static constexpr int max_pass_generations = 16;
+
+    // Maps a new zeroed scratch file of buffer_size bytes, throws
+    // std::system_error on failure
+    [[nodiscard]] uint8_t *mapScratchFile(const std::string &directory) const;
+
+    // Unmaps the files and frees the bands, also after a failed constructor
+    void releaseMemory();
+
+    // Single pass over the files advancing every band by the generations
+    void advancePass(int generations);
+
+    // madvise on the pages holding rows [from, to) of the buffer
+    void adviseRows(uint8_t *buffer, int from, int to, int advice) const;
+
+    int band_rows;
+    // Band and its margins plus ghost rows, one buffer per generation parity
+    uint8_t *band;
+    uint8_t *new_band;
+};
+
+// 64 cells per word, neighbors are counted with bit-sliced adders
+class BitpackedEngine : public Engine {
+public:
+    BitpackedEngine(const Board &board, int start_row, int rows_number);
+
+    ~BitpackedEngine() override;
+
+    void copyRow(int y, Cell *out) const override;
+
+    void copyBoard(Cell *out) const override;
+
+    void printNumaReport(int proc_id) const override;
+
+    void updateBoardRows(int from, int to) override;
+
+    void updateBoardEdges(
+        const Cell *upperGhostRow,
+        const Cell *lowerGhostRow
+    ) override;
+
+private:
+    [[nodiscard]] uint64_t *getRow(uint64_t *buffer, int y) const;
+
+    void packRow(const Cell *cells, uint64_t *words) const;
+
+    void unpackRow(const uint64_t *words, Cell *cells) const;
+
+    void updateRow(
+        const uint64_t *prevRow,
+        const uint64_t *currRow,
+        const uint64_t *nextRow,
+        uint64_t *newRow
+    ) const;
+
+    int words_count;
+    int stride;
+    uint64_t last_word_mask;
+    size_t buffer_size;
+    uint64_t *board;
+    uint64_t *new_board;
+};
+
+// Creates engine with a copy of the given rows of the board
+std::unique_ptr<Engine> createEngine(
+    EngineType type,
+    const Board &board,
+    int start_row,
+    int rows_number
+);
+
+#endif  // ENGINE_HPP
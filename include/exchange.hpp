@@ -0,0 +1,129 @@
+#ifndef EXCHANGE_HPP
+#define EXCHANGE_HPP
+
+#include <mpi.h>
+
+#include <memory>
+#include <vector>
+
+#include "../include/engine.hpp"
+#include "../include/executor.hpp"
+#include "../include/utils.hpp"
+
+// Strategy of exchanging edge rows between neighboring working processes.
+// Processes are ordered by id, process 0 holds the top strip. Rows travel as
+// MPI_BYTE messages in the wire format of encodeCells.
+class Exchange {
+public:
+    Exchange(int proc_id, int last_proc_id, int width);
+
+    virtual ~Exchange();
+
+    // Advances the engine by one generation
+    virtual void step(Engine &engine) = 0;
+
+    // Advances the engine by several generations
+    virtual void advance(Engine &engine, int generations);
+
+    // Executor the strategy steps on, other MPI traffic of the process can
+    // await on it too. Null for strategies without one.
+    virtual Executor *getExecutor() { return nullptr; }
+
+protected:
+    [[nodiscard]] bool hasUpperNeighbor() const;
+
+    [[nodiscard]] bool hasLowerNeighbor() const;
+
+    [[nodiscard]] const Cell *getUpperGhostRow() const;
+
+    [[nodiscard]] const Cell *getLowerGhostRow() const;
+
+    // Copies row y out of the engine and encodes it into the message,
+    // returns the message size
+    int packEdgeRow(
+        const Engine &engine,
+        int y,
+        Cell *row,
+        std::vector<uint8_t> &message
+    ) const;
+
+    // Decodes the received messages into the ghost rows
+    void unpackGhostRows();
+
+    // Encodes the edge rows and posts MPI_Irecv/MPI_Isend with both
+    // neighbors, requests of missing neighbors stay null. The ghost rows
+    // need unpackGhostRows once the requests complete.
+    void postEdgeRows(const Engine &engine, MPI_Request requests[4]);
+
+    int proc_id;
+    int last_proc_id;
+    int width;
+    // Received rows of the neighbors
+    Cell *upper_ghost_row;
+    Cell *lower_ghost_row;
+    // Own edge rows copied out of the engine
+    Cell *upper_edge_row;
+    Cell *lower_edge_row;
+    // Encoded edge rows and messages of the neighbors, maxEncodedSize bytes
+    int message_capacity;
+    std::vector<uint8_t> upper_edge_message;
+    std::vector<uint8_t> lower_edge_message;
+    std::vector<uint8_t> upper_ghost_message;
+    std::vector<uint8_t> lower_ghost_message;
+};
+
+// Single working process, the board has dead borders only
+class NoExchange : public Exchange {
+public:
+    using Exchange::Exchange;
+
+    void step(Engine &engine) override;
+
+    void advance(Engine &engine, int generations) override;
+};
+
+// MPI_Sendrecv with both neighbors, then the whole board update
+class BlockingExchange : public Exchange {
+public:
+    using Exchange::Exchange;
+
+    void step(Engine &engine) override;
+};
+
+// MPI_Isend/MPI_Irecv posted before the interior update, edge rows are
+// updated once the ghost rows arrive
+class OverlappedExchange : public Exchange {
+public:
+    using Exchange::Exchange;
+
+    void step(Engine &engine) override;
+};
+
+// Every generation is a coroutine on the Executor awaiting the edge rows while
+// the interior is updated in bands of rows. MPI_Testsome runs between the
+// bands, so the messages progress without a progress thread.
+class CoroutineExchange : public Exchange {
+public:
+    using Exchange::Exchange;
+
+    void step(Engine &engine) override;
+
+    Executor *getExecutor() override { return &executor; }
+
+private:
+    // Cells of a single interior band
+    static constexpr size_t band_cells = 1 << 18;
+
+    Task stepGeneration(Engine &engine);
+
+    Executor executor;
+};
+
+std::unique_ptr<Exchange> createExchange(
+    ExchangeType type,
+    int proc_id,
+    int last_proc_id,
+    int width
+);
+
+#endif  // EXCHANGE_HPP
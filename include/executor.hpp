@@ -0,0 +1,155 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <mpi.h>
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Coroutine run by the Executor, it starts suspended and is destroyed with
+// the Task object
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() {
+            return Task(
+                std::coroutine_handle<promise_type>::from_promise(*this)
+            );
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task &&other) noexcept;
+
+    Task(const Task &) = delete;
+
+    Task &operator=(Task &&other) noexcept;
+
+    Task &operator=(const Task &) = delete;
+
+    ~Task();
+
+    [[nodiscard]] bool isDone() const;
+
+private:
+    friend class Executor;
+
+    explicit Task(std::coroutine_handle<promise_type> handle);
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Single threaded executor interleaving compute with MPI progress. Coroutines
+// suspend on MPI requests (halo rows, snapshots, non-blocking reductions) or
+// on a batch of compute chunks. The executor runs one chunk at a time and
+// calls MPI_Testsome on every pending request in between, resuming the
+// coroutines whose requests completed. With nothing to compute it blocks in
+// MPI_Waitsome. Background tasks progress whenever the executor runs.
+class Executor {
+    struct ComputeBatch {
+        std::function<void(int)> execute;
+        int chunks_count;
+        int next_chunk = 0;
+        int remaining;
+        std::coroutine_handle<> waiting = nullptr;
+    };
+
+public:
+    // Resumes the coroutine once all the requests completed
+    class RequestsAwaiter {
+    public:
+        RequestsAwaiter(Executor &executor, MPI_Request *requests, int count);
+
+        [[nodiscard]] bool await_ready() const;
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const {}
+
+    private:
+        friend class Executor;
+
+        Executor &executor;
+        MPI_Request *requests;
+        int count;
+        int remaining = 0;
+        std::coroutine_handle<> waiting = nullptr;
+    };
+
+    // Resumes the coroutine once all chunks of the batch were executed
+    class ComputeAwaiter {
+    public:
+        explicit ComputeAwaiter(std::shared_ptr<ComputeBatch> batch);
+
+        [[nodiscard]] bool await_ready() const;
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const {}
+
+    private:
+        std::shared_ptr<ComputeBatch> batch;
+    };
+
+    // Adds a background task, it starts on the next run
+    void spawn(Task task);
+
+    // Runs until the task finishes
+    void run(Task task);
+
+    // Runs until done returns true
+    void runUntil(const std::function<bool()> &done);
+
+    // Runs until every background task finishes
+    void drain();
+
+    // Runs until the requests complete
+    void waitFor(MPI_Request *requests, int count);
+
+    // Awaitable for the requests, MPI_REQUEST_NULL entries are skipped.
+    // Completed requests are set to MPI_REQUEST_NULL.
+    [[nodiscard]] RequestsAwaiter wait(MPI_Request *requests, int count);
+
+    // Queues chunks [0, chunks_count) of compute right away, awaiting the
+    // result waits for the whole batch
+    [[nodiscard]] ComputeAwaiter compute(
+        int chunks_count,
+        std::function<void(int)> execute
+    );
+
+private:
+    [[nodiscard]] bool isDone() const;
+
+    Task awaitRequests(MPI_Request *requests, int count);
+
+    void resumeReady();
+
+    // Executes the next queued chunk
+    void computeChunk();
+
+    // Tests (or waits for, if block is set) the pending requests
+    void poll(bool block);
+
+    std::vector<Task> tasks;
+    std::deque<std::coroutine_handle<>> ready;
+    std::deque<std::shared_ptr<ComputeBatch>> batches;
+    // Copies of the requests of the suspended coroutines, with the awaiter
+    // and index in its array of each of them
+    std::vector<MPI_Request> pending_requests;
+    std::vector<std::pair<RequestsAwaiter *, int>> request_owners;
+    std::vector<int> completed_indices;
+};
+
+#endif  // EXECUTOR_HPP
@@ -0,0 +1,50 @@
+#ifndef MPI_UTILS_HPP
+#define MPI_UTILS_HPP
+
+#include <mpi.h>
+
+#include <cstddef>
+
+// MPI counts are int, so longer messages are split into chunks of at most
+// this many elements. Chunks are sent with the same tag, MPI keeps their
+// order between a pair of processes.
+#ifndef MAX_MESSAGE_COUNT
+#define MAX_MESSAGE_COUNT (1 << 30)
+#endif
+
+// Lowers the chunk size below MAX_MESSAGE_COUNT, so tests can split small
+// boards into many chunks. Every process must set the same size before any
+// chunked message.
+void setMaxMessageCount(size_t count);
+
+// Number of chunks (and requests) needed for a message of count elements
+int chunksCount(size_t count);
+
+// Non-blocking send of count elements, requests must have room for
+// chunksCount(count) requests
+int isendChunked(
+    const void *data,
+    size_t count,
+    MPI_Datatype type,
+    int dest,
+    int tag,
+    MPI_Request *requests
+);
+
+// Non-blocking receive of count elements, requests must have room for
+// chunksCount(count) requests
+int irecvChunked(
+    void *data,
+    size_t count,
+    MPI_Datatype type,
+    int source,
+    int tag,
+    MPI_Request *requests
+);
+
+// Index of this process among the processes of its node that have the same
+// CPU affinity mask and pin threads, and their count. Collective, processes
+// that do not pin threads get slot 0.
+void getAffinitySlot(bool pins_threads, int *slot, int *slots_count);
+
+#endif  // MPI_UTILS_HPP
@@ -0,0 +1,51 @@
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <cstddef>
+
+// Board buffers are first touched by the OpenMP threads that later update
+// them, so on multi-socket machines their pages land on the thread's NUMA
+// node instead of the node of the main thread.
+
+// Backs board buffers allocated from now on with transparent huge pages
+void setHugePages(bool enabled);
+
+// Allocates memory aligned to 64 bytes (2 MiB with huge pages). Memory is not
+// initialized, see firstTouchRows.
+void *allocateBoardMemory(size_t bytes);
+
+void freeBoardMemory(void *data);
+
+// Zeroes rows_count rows of row_bytes bytes. Rows [parallel_first,
+// parallel_last) are zeroed with the same schedule(static) distribution the
+// update loops use over that range, the rest by the calling thread.
+void firstTouchRows(
+    void *data,
+    size_t row_bytes,
+    int rows_count,
+    int parallel_first,
+    int parallel_last
+);
+
+// Pins every OpenMP thread to a single CPU of the process affinity mask,
+// unless OMP_PROC_BIND already asks the runtime to do it. Processes sharing
+// the mask split it: process `slot` of `slots_count` pins its threads to
+// the slot-th part of the mask only.
+void pinThreads(int slot, int slots_count);
+
+// Pins the calling thread to the CPU pinThreads gave OpenMP thread
+// thread_id, for threads outside of OpenMP. Does nothing if pinThreads did
+// not pin.
+void pinCurrentThread(int thread_id);
+
+// Prints CPU and NUMA node of every OpenMP thread together with the node of
+// the pages of the rows it updates
+void printNumaReport(
+    const void *data,
+    size_t row_bytes,
+    int parallel_first,
+    int parallel_last,
+    int proc_id
+);
+
+#endif  // NUMA_HPP
@@ -0,0 +1,73 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool of threads executing integer tasks. Every worker pops tasks from the
+// back of its own deque and steals from the front of the others when it runs
+// out of work. The calling thread takes part in run() as worker 0.
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(int threads_count);
+
+    ~WorkStealingScheduler();
+
+    [[nodiscard]] int getThreadsCount() const;
+
+    // Executes the tasks and every task they spawn, returns once all of them
+    // are done
+    void run(
+        const std::vector<int> &tasks,
+        const std::function<void(int)> &execute
+    );
+
+    // Adds a task to the deque of the calling worker, may only be called from
+    // inside a running task
+    void spawn(int task);
+
+    // Threads of the OpenMP runtime if enabled, CPUs of the process affinity
+    // mask otherwise
+    static int defaultThreadsCount();
+
+    // Worker of the calling thread, 0 for the thread inside run() and -1
+    // outside of the scheduler
+    static int currentWorkerId();
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void workerLoop(int worker_id);
+
+    // Executes tasks until every task of the current run is done
+    void work(int worker_id);
+
+    bool pop(int worker_id, int &task);
+
+    bool steal(int worker_id, int &task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    const std::function<void(int)> *execute = nullptr;
+    // Spawned tasks that are not done yet
+    std::atomic<long> pending_tasks{0};
+    // Helper threads inside work()
+    std::atomic<int> active_workers{0};
+
+    std::mutex run_mutex;
+    std::condition_variable run_started;
+    long run_id = 0;
+    bool stopping = false;
+};
+
+#endif  // SCHEDULER_HPP
@@ -0,0 +1,86 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../include/board.hpp"
+#include "../include/engine.hpp"
+#include "../include/executor.hpp"
+#include "../include/utils.hpp"
+
+// First message of every snapshot sent to the collector
+struct SnapshotHeader {
+    int32_t generation;
+    // Bytes of the encoded strip after the header
+    uint64_t encoded_size;
+};
+
+// Worker side of the verbose mode. Each snapshot is encoded into one of two
+// send buffers so the strip can be updated while MPI completes the send in
+// the background. Every snapshot is a SnapshotHeader message followed by the
+// strip in the wire format of encodeCells, long strips are sent in chunks.
+// With an executor every send is awaited by a background task, so it
+// progresses between the compute chunks of the executor, and waiting for a
+// free buffer runs the executor instead of blocking in MPI.
+class SnapshotSender {
+public:
+    SnapshotSender(
+        int collector_id,
+        size_t cells_count,
+        SnapshotPolicy policy,
+        Executor *executor = nullptr
+    );
+
+    // Encodes the engine board and sends it. Returns false if the frame was
+    // dropped because the next buffer is still busy, forced frames are never
+    // dropped.
+    bool send(const Engine &engine, int generation, bool force = false);
+
+    // Lets MPI progress the in-flight sends without blocking
+    void progress();
+
+    // Waits for all in-flight sends
+    void flush();
+
+    [[nodiscard]] int getDroppedCount() const;
+
+private:
+    static constexpr int buffers_count = 2;
+
+    // Whether every send from the buffer completed
+    [[nodiscard]] bool isBufferFree(int buffer) const;
+
+    // Background task completing the sends from the buffer
+    Task awaitSends(int buffer);
+
+    int collector_id;
+    size_t cells_count;
+    SnapshotPolicy policy;
+    Executor *executor;
+    int dropped_count = 0;
+    // Buffers are used in turns
+    int next_buffer = 0;
+    std::vector<uint8_t> buffers[buffers_count];
+    // Chunk requests of every buffer
+    std::vector<MPI_Request> requests[buffers_count];
+};
+
+// Collector side of the verbose mode. Saves the initial board, then assembles
+// frames from the workers strips and saves every complete one until the last
+// generation arrives from all workers. Frames that some worker dropped are
+// skipped. Strips are decoded straight into the pixels of the frames.
+void collectSnapshots(
+    int board_size,
+    BoardInitType init_type,
+    const int *start_rows,
+    const int *num_rows,
+    int workers_count,
+    int iterations,
+    const std::string &output_directory
+);
+
+#endif  // SNAPSHOT_HPP
@@ -1,16 +1,55 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cstdint>
 #include <string>
 
 #include "../include/board.hpp"
 
+// What a worker does with a snapshot when the collector has not yet drained
+// both of its send buffers
+enum SnapshotPolicy {
+    BLOCK = 0,  // wait for a free buffer, every frame is saved
+    DROP = 1,   // skip the frame and keep computing
+};
+
+// Stepping backend of the working processes
+enum EngineType {
+    SCALAR = 0,      // Board::updateRow
+    VECTORIZED = 1,  // branchless byte kernel
+    BITPACKED = 2,   // 64 cells per word, bit-sliced neighbor count
+    SPARSE = 3,      // byte kernel skipping dead neighborhoods
+    TILED = 4,       // byte kernel on 2D tiles run by a work-stealing pool
+};
+
+// How the working processes exchange edge rows
+enum ExchangeType {
+    NONE = 0,        // single working process, no exchange
+    BLOCKING = 1,    // MPI_Sendrecv before the update
+    OVERLAPPED = 2,  // MPI_Isend/MPI_Irecv overlapped with the interior
+    COROUTINE = 3,   // coroutines polling MPI between interior bands
+};
+
 struct Args {
-    int board_size;
-    int iterations;
-    BoardInitType init_type;
+    int board_size = 0;
+    int iterations = 0;
+    BoardInitType init_type = LINE;
     std::string output_directory;
     bool is_verbose = false;
+    // Save every N-th generation (the last one is always saved)
+    int snapshot_interval = 1;
+    SnapshotPolicy snapshot_policy = BLOCK;
+    EngineType engine_type = SCALAR;
+    ExchangeType exchange_type = OVERLAPPED;
+    bool print_hashes = false;
+    bool huge_pages = false;
+    bool print_numa_report = false;
+    // Keep the board in scratch files of this directory instead of memory
+    std::string out_of_core_directory;
+    // Bytes of an out-of-core band buffer, 0 for OUT_OF_CORE_BAND_BYTES
+    long out_of_core_band_bytes = 0;
+    // Elements of a chunk of long messages, 0 for MAX_MESSAGE_COUNT
+    long max_message_count = 0;
 };
 
 struct PGM {
@@ -24,6 +63,22 @@ struct PGM {
 
 int parseArguments(int argc, char* argv[], Args* args);
 
+// Splits rows between processes as evenly as possible
+void partitionRows(
+    int rows_count,
+    int procs_count,
+    int* start_rows,
+    int* num_rows
+);
+
+// Order independent hash of the alive cells, hashes of the parts of a board
+// add up to the hash of the whole board. first_index is the index of the
+// first cell within the whole board.
+uint64_t hashCells(const Cell* cells, size_t count, size_t first_index);
+
+// Whether a snapshot of the given generation should be saved
+bool isSnapshotGeneration(const Args& args, int generation);
+
 PGM PGMFromBoard(const Board& board);
 
 PGM PGMFromCells(
@@ -0,0 +1,50 @@
+#ifndef WIRE_HPP
+#define WIRE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "../include/board.hpp"
+
+// Compact encoding of Cell arrays sent over MPI as bytes. The first byte is
+// the format chosen for the message, the receiver knows the cells count.
+enum WireFormat : uint8_t {
+    WIRE_BITS = 0,  // 8 cells per byte, least significant bit first
+    WIRE_RUNS = 1,  // lengths of alternating dead and alive runs, starting
+                    // with a dead one, as LEB128 varints
+};
+
+// Upper bound of the encoded size of count cells
+size_t maxEncodedSize(size_t count);
+
+// Encodes the cells into out, which needs maxEncodedSize(count) bytes.
+// Runs are chosen whenever they are shorter than the bits, so sparse or
+// uniform rows shrink further. Returns the encoded size.
+size_t encodeCells(const Cell *cells, size_t count, uint8_t *out);
+
+// Encodes height rows of width cells into the same bytes as encodeCells,
+// copy_row copies row y into a buffer of width cells, so only a row is held
+// at a time. Rows are copied twice: to choose the format, which stops once
+// runs get longer than bits, and to encode them.
+size_t encodeRows(
+    const std::function<void(int, Cell *)> &copy_row,
+    int width,
+    int height,
+    uint8_t *out
+);
+
+// Decodes count cells encoded by encodeCells
+void decodeCells(const uint8_t *data, size_t count, Cell *out);
+
+// Decodes count cells encoded by encodeCells as one byte each, dead or alive,
+// e.g. straight into the pixels of a PGM
+void decodeCells(
+    const uint8_t *data,
+    size_t count,
+    uint8_t *out,
+    uint8_t dead,
+    uint8_t alive
+);
+
+#endif  // WIRE_HPP
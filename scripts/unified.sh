@@ -0,0 +1,13 @@
+#!/bin/bash
+
+SIZE=${1:-100}
+ITERATIONS=${2:-100}
+TYPE=${3:-0}       # Default to LINE
+NUM_PROCS=${4:-4}
+EXECUTABLE=${5:-cmake-build-debug/solutions/unified/unified_solution}
+OUTPUT_DIR=${6:-cmake-build-debug/solutions/unified/snapshots}
+
+# Remaining arguments are passed as options, e.g. --engine=bitpacked
+
+# Run the MPI command
+mpirun -n $NUM_PROCS -v $EXECUTABLE $SIZE $ITERATIONS $TYPE $OUTPUT_DIR "${@:7}"
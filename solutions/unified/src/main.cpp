@@ -0,0 +1,7 @@
+#include <driver.hpp>
+
+int main(int argc, char *argv[]) {
+    // Engine and exchange strategy are selected with --engine and --exchange
+    Args args;
+    return runSolution(argc, argv, args);
+}
@@ -1,8 +1,9 @@
 #include "../include/board.hpp"
 
 #include <cstring>
-#include <new>
 #include <utility>
+
+#include "../include/numa.hpp"
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -10,57 +11,84 @@
 // Constructors
 
 Board::Board(const int width, const int height)
-    : width(width), height(height), board(new(std::align_val_t(64)) Cell[width * height]{}),
-      new_board(new(std::align_val_t(64)) Cell[width * height]{}) {
+    : width(width), height(height),
+      board(
+          static_cast<Cell *>(allocateBoardMemory(sizeof(Cell) * getSize()))
+      ),
+      new_board(
+          static_cast<Cell *>(allocateBoardMemory(sizeof(Cell) * getSize()))
+      ) {
+    // Middle rows are first touched by the threads updating them
+    firstTouchRows(board, sizeof(Cell) * width, height, 1, height - 1);
+    firstTouchRows(new_board, sizeof(Cell) * width, height, 1, height - 1);
 }
 
 Board::~Board() {
-    operator delete[](board, std::align_val_t(64));
-    operator delete[](new_board, std::align_val_t(64));
+    freeBoardMemory(board);
+    freeBoardMemory(new_board);
 }
 
 // Accessors
 
-Cell *Board::getRow(const int y) const { return &board[y * width]; }
+Cell *Board::getRow(const int y) const { return &board[offset(y)]; }
 
 int Board::getWidth() const { return width; }
 
 int Board::getHeight() const { return height; }
 
+size_t Board::getSize() const { return offset(height); }
+
 Cell *Board::getBoard() const { return board; }
 
+size_t Board::offset(const int y) const {
+    return static_cast<size_t>(y) * width;
+}
+
 // Mutators
 
 inline void Board::setCell(const int x, const int y, const Cell value) {
-    board[y * width + x] = value;
+    board[offset(y) + x] = value;
 }
 
 void Board::setBoard(Cell *new_board) {
-    operator delete[](board, std::align_val_t(64));
+    freeBoardMemory(board);
     board = new_board;
 }
 
-void Board::Init(const BoardInitType type) {
+void Board::Init(const BoardInitType type) { Init(type, 0, height); }
+
+void Board::Init(
+    const BoardInitType type,
+    const int first_row,
+    const int board_height
+) {
+    // Only cells of rows held by this board are set
+    const auto setBoardCell = [&](const int x, const int row) {
+        if (row >= first_row && row < first_row + height) {
+            setCell(x, row - first_row, ALIVE);
+        }
+    };
+
     switch (type) {
         case LINE:
-            for (int i = 0; i < height; ++i) {
-                setCell(width / 2, i, ALIVE);
+            for (int i = 0; i < board_height; ++i) {
+                setBoardCell(width / 2, i);
             }
             break;
         case T_SHAPE:
-            for (int i = 0; i < height; ++i) {
-                setCell(width / 2, i, ALIVE);
+            for (int i = 0; i < board_height; ++i) {
+                setBoardCell(width / 2, i);
             }
             for (int i = 0; i < width; ++i) {
-                setCell(i, 0, ALIVE);
+                setBoardCell(i, 0);
             }
             break;
         case CROSS:
-            for (int i = 0; i < height; ++i) {
-                setCell(i, height / 2, ALIVE);
+            for (int i = 0; i < board_height; ++i) {
+                setBoardCell(i, board_height / 2);
             }
             for (int i = 0; i < width; ++i) {
-                setCell(width / 2, i, ALIVE);
+                setBoardCell(width / 2, i);
             }
             break;
     }
@@ -105,11 +133,11 @@ inline void Board::updateRow(
 }
 
 void Board::updateBoard(const Cell *upperGhostRow, const Cell *lowerGhostRow) {
-    // first row
+    // first row, the lower ghost row is right below a single row strip
     updateRow(
         upperGhostRow,
-        &board[0 * width],
-        &board[1 * width],
+        &board[offset(0)],
+        height > 1 ? &board[offset(1)] : lowerGhostRow,
         &new_board[0]
     );
 
@@ -117,34 +145,39 @@ void Board::updateBoard(const Cell *upperGhostRow, const Cell *lowerGhostRow) {
 #pragma omp parallel for schedule(static)
     for (int i = 1; i < height - 1; ++i) {
         updateRow(
-            &board[(i - 1) * width],
-            &board[i * width],
-            &board[(i + 1) * width],
-            &new_board[i * width]
+            &board[offset(i - 1)],
+            &board[offset(i)],
+            &board[offset(i + 1)],
+            &new_board[offset(i)]
         );
     }
 
     // last row
-    updateRow(
-        &board[(height - 2) * width],
-        &board[(height - 1) * width],
-        lowerGhostRow,
-        &new_board[(height - 1) * width]
-    );
+    if (height > 1) {
+        updateRow(
+            &board[offset(height - 2)],
+            &board[offset(height - 1)],
+            lowerGhostRow,
+            &new_board[offset(height - 1)]
+        );
+    }
 
     std::swap(board, new_board);
 }
 
 void Board::updateBoardWithoutEdges() {
-
     // middle rows
+    updateBoardRows(1, height - 1);
+}
+
+void Board::updateBoardRows(const int from, const int to) {
 #pragma omp parallel for schedule(static)
-    for (int i = 1; i < height - 1; ++i) {
+    for (int i = from; i < to; ++i) {
         updateRow(
-            &board[(i - 1) * width],
-            &board[i * width],
-            &board[(i + 1) * width],
-            &new_board[i * width]
+            &board[offset(i - 1)],
+            &board[offset(i)],
+            &board[offset(i + 1)],
+            &new_board[offset(i)]
         );
     }
 }
@@ -153,21 +186,23 @@ void Board::updateBoardEdges(
     const Cell *upperGhostRow,
     const Cell *lowerGhostRow
 ) {
-    // first row
+    // first row, the lower ghost row is right below a single row strip
     updateRow(
         upperGhostRow,
-        &board[0 * width],
-        &board[1 * width],
+        &board[offset(0)],
+        height > 1 ? &board[offset(1)] : lowerGhostRow,
         &new_board[0]
     );
 
     // last row
-    updateRow(
-        &board[(height - 2) * width],
-        &board[(height - 1) * width],
-        lowerGhostRow,
-        &new_board[(height - 1) * width]
-    );
+    if (height > 1) {
+        updateRow(
+            &board[offset(height - 2)],
+            &board[offset(height - 1)],
+            lowerGhostRow,
+            &new_board[offset(height - 1)]
+        );
+    }
 
     std::swap(board, new_board);
 }
@@ -179,16 +214,17 @@ Board Board::createSubBoard(
     const int start_row,
     const int rows_number
 ) {
-    const Cell *parent_board_data = board.getBoard();
     Board sub_board(board.getWidth(), rows_number);
-    Cell *sub_board_data = sub_board.getBoard();
 
-    const int offset = start_row * sub_board.width;
-    std::memcpy(
-        sub_board_data,
-        parent_board_data + offset,
-        sizeof(Cell) * sub_board.width * rows_number
-    );
+    // Pages are already placed by the first touch in the constructor
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < rows_number; ++i) {
+        std::memcpy(
+            sub_board.getRow(i),
+            board.getRow(start_row + i),
+            sizeof(Cell) * sub_board.width
+        );
+    }
 
     return sub_board;
 }
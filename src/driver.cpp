@@ -0,0 +1,309 @@
+#include "../include/driver.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../include/engine.hpp"
+#include "../include/exchange.hpp"
+#include "../include/mpi_utils.hpp"
+#include "../include/numa.hpp"
+#include "../include/snapshot.hpp"
+
+// Generation the main loop stops at next. Exchange none advances the board
+// up to the next snapshot in one go, other strategies go one by one.
+int getNextGeneration(const Args &args, const int generation) {
+    if (args.exchange_type != NONE) {
+        return generation + 1;
+    }
+    if (!args.is_verbose && !args.print_hashes) {
+        return args.iterations;
+    }
+    const int interval = args.snapshot_interval;
+    return std::min(args.iterations, (generation / interval + 1) * interval);
+}
+
+// Sums hashes of all strips on the first process and prints them for every
+// snapshot generation, the verbose process takes part with zeros. With an
+// executor the reduction is awaited on it, so its other tasks progress.
+void printHashes(
+    std::vector<uint64_t> &hashes,
+    const Args &args,
+    const int proc_id,
+    Executor *executor
+) {
+    std::vector<uint64_t> board_hashes(hashes.size());
+    MPI_Request request;
+    MPI_Ireduce(
+        hashes.data(),
+        board_hashes.data(),
+        static_cast<int>(hashes.size()),
+        MPI_UINT64_T,
+        MPI_SUM,
+        0,
+        MPI_COMM_WORLD,
+        &request
+    );
+    if (executor) {
+        executor->waitFor(&request, 1);
+    } else {
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+    }
+
+    if (proc_id == 0) {
+        for (int generation = 0; generation <= args.iterations; ++generation) {
+            if (!isSnapshotGeneration(args, generation)) {
+                continue;
+            }
+            std::cout << "hash " << generation << " " << std::hex
+                      << board_hashes[generation] << std::dec << "\n";
+        }
+        std::cout << std::flush;
+    }
+}
+
+int runSolution(int argc, char *argv[], Args args) {
+    MPI_Init(&argc, &argv);
+
+    int proc_id, procs_count;
+    MPI_Comm_rank(MPI_COMM_WORLD, &proc_id);
+    MPI_Comm_size(MPI_COMM_WORLD, &procs_count);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double time_start = MPI_Wtime();
+
+    // #1 Parse command-line arguments
+    if (parseArguments(argc, argv, &args) == 1) {
+        MPI_Finalize();
+        return 1;
+    }
+    if (args.max_message_count > 0) {
+        setMaxMessageCount(args.max_message_count);
+    }
+    const bool verbose = args.is_verbose;
+    const int iterations = args.iterations;
+    const int board_size = args.board_size;
+
+    // #2 Verbose process is needed only if there are other processes
+    const bool has_verbose_proc = verbose && procs_count > 1;
+    const int working_procs_count =
+        has_verbose_proc ? procs_count - 1 : procs_count;
+    // Id of the last working process (not verbose one)
+    const int last_proc_id = working_procs_count - 1;
+
+    if (args.exchange_type == NONE && working_procs_count > 1) {
+        if (proc_id == 0) {
+            std::cerr << "Exchange none requires a single working process."
+                      << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    if (!args.out_of_core_directory.empty() &&
+        (args.exchange_type != NONE || verbose)) {
+        if (proc_id == 0) {
+            std::cerr << "Out-of-core mode requires exchange none and no "
+                         "verbose output."
+                      << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    if (board_size < working_procs_count) {
+        if (proc_id == 0) {
+            std::cerr << "Board has fewer rows than working processes."
+                      << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    // #3 Calculate number of rows for each process
+    int *start_rows = new int[working_procs_count],
+        *num_rows = new int[working_procs_count];
+    partitionRows(board_size, working_procs_count, start_rows, num_rows);
+
+    // Working processes sharing a node and a CPU mask pin their threads to
+    // disjoint CPUs, the verbose process does not pin its threads
+    const bool is_verbose_proc =
+        has_verbose_proc && proc_id == last_proc_id + 1;
+    int affinity_slot, affinity_slots_count;
+    getAffinitySlot(!is_verbose_proc, &affinity_slot, &affinity_slots_count);
+
+    // #4.1 If verbose process (last process) gather data and save snapshots
+    if (is_verbose_proc) {
+        // Only the verbose process holds whole boards, as pixels
+        collectSnapshots(
+            board_size,
+            args.init_type,
+            start_rows,
+            num_rows,
+            working_procs_count,
+            iterations,
+            args.output_directory
+        );
+
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        if (args.print_hashes) {
+            std::vector<uint64_t> hashes(iterations + 1, 0);
+            printHashes(hashes, args, proc_id, nullptr);
+        }
+
+        delete[] start_rows;
+        delete[] num_rows;
+        MPI_Finalize();
+        return 0;
+    }
+
+    const int proc_start_row = start_rows[proc_id];
+    const int proc_rows_num = num_rows[proc_id];
+    // Strip and board sizes may exceed the int range
+    const size_t proc_cells_count =
+        static_cast<size_t>(board_size) * proc_rows_num;
+    const size_t proc_first_cell =
+        static_cast<size_t>(board_size) * proc_start_row;
+
+    // #4.2 Init board part and pass it to the engine. Threads are pinned
+    // first, so the board pages are first touched where they are updated.
+    pinThreads(affinity_slot, affinity_slots_count);
+    setHugePages(args.huge_pages);
+    std::unique_ptr<Engine> engine;
+    if (!args.out_of_core_directory.empty()) {
+        // The only process, the board never exists in memory as a whole
+        try {
+            engine = std::make_unique<OutOfCoreEngine>(
+                args.out_of_core_directory,
+                board_size,
+                board_size,
+                args.init_type,
+                args.out_of_core_band_bytes > 0 ? args.out_of_core_band_bytes
+                                                : OUT_OF_CORE_BAND_BYTES
+            );
+        } catch (const std::exception &error) {
+            std::cerr << "Failed to create the out-of-core board: "
+                      << error.what() << std::endl;
+            delete[] start_rows;
+            delete[] num_rows;
+            MPI_Finalize();
+            return 1;
+        }
+    } else {
+        Board proc_board(board_size, proc_rows_num);
+        proc_board.Init(args.init_type, proc_start_row, board_size);
+        engine =
+            createEngine(args.engine_type, proc_board, 0, proc_rows_num);
+    }
+    if (args.print_numa_report) {
+        engine->printNumaReport(proc_id);
+    }
+    std::unique_ptr<Exchange> exchange = createExchange(
+        args.exchange_type,
+        proc_id,
+        last_proc_id,
+        board_size
+    );
+
+    // Snapshots are either sent to the verbose process from double buffers
+    // in the background or saved right away by the only process
+    std::unique_ptr<SnapshotSender> snapshot_sender;
+    Cell *snapshot_board = nullptr;
+    if (has_verbose_proc) {
+        snapshot_sender = std::make_unique<SnapshotSender>(
+            last_proc_id + 1,
+            proc_cells_count,
+            args.snapshot_policy,
+            exchange->getExecutor()
+        );
+    } else if (verbose) {
+        snapshot_board = new Cell[proc_cells_count];
+        engine->copyBoard(snapshot_board);
+        savePGM(
+            PGMFromCells(snapshot_board, board_size, board_size, nullptr, 0),
+            args.output_directory,
+            0
+        );
+    }
+
+    // Hash of the strip after every snapshot generation
+    std::vector<uint64_t> hashes;
+    if (args.print_hashes) {
+        hashes.resize(iterations + 1, 0);
+        hashes[0] = engine->hashBoard(proc_first_cell);
+    }
+
+    const double loop_time_start = MPI_Wtime();
+    int generation = 0;
+    while (generation < iterations) {
+        // #5 Exchange edge rows and update board
+        const int next_generation = getNextGeneration(args, generation);
+        exchange->advance(*engine, next_generation - generation);
+        generation = next_generation;
+
+        if (args.print_hashes && isSnapshotGeneration(args, generation)) {
+            hashes[generation] = engine->hashBoard(proc_first_cell);
+        }
+
+        // #6 If verbose save snapshot or send it to verbose process
+        if (snapshot_sender) {
+            if (isSnapshotGeneration(args, generation)) {
+                // The last generation is never dropped, so the verbose
+                // process knows when to stop
+                snapshot_sender->send(
+                    *engine,
+                    generation,
+                    generation == iterations
+                );
+            } else {
+                snapshot_sender->progress();
+            }
+        } else if (verbose && isSnapshotGeneration(args, generation)) {
+            engine->copyBoard(snapshot_board);
+            savePGM(
+                PGMFromCells(snapshot_board, board_size, board_size, nullptr, 0),
+                args.output_directory,
+                generation
+            );
+        }
+    }
+
+    if (snapshot_sender) {
+        snapshot_sender->flush();
+        if (snapshot_sender->getDroppedCount() > 0) {
+            std::cerr << "Process " << proc_id << " dropped "
+                      << snapshot_sender->getDroppedCount() << " snapshots"
+                      << std::endl;
+        }
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double time_end = MPI_Wtime();
+
+    // #7 Write elapsed time and throughput of the generations loop (first
+    // process only)
+    if (proc_id == 0) {
+        const double cell_updates =
+            static_cast<double>(board_size) * board_size * iterations;
+        std::cout << time_end - time_start << " - elapsed time in seconds"
+                  << std::endl;
+        std::cout << std::fixed << std::setprecision(0)
+                  << cell_updates / (time_end - loop_time_start)
+                  << " - cell updates per second" << std::defaultfloat
+                  << std::endl;
+    }
+
+    if (args.print_hashes) {
+        printHashes(hashes, args, proc_id, exchange->getExecutor());
+    }
+
+    delete[] snapshot_board;
+    delete[] start_rows;
+    delete[] num_rows;
+    MPI_Finalize();
+    return 0;
+}
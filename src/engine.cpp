@@ -0,0 +1,147 @@
+#include "../include/engine.hpp"
+
+#include <cstring>
+
+#include "../include/numa.hpp"
+
+// Engine
+
+Engine::Engine(const int width, const int height)
+    : width(width), height(height) {}
+
+int Engine::getWidth() const { return width; }
+
+int Engine::getHeight() const { return height; }
+
+void Engine::updateBoard(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    updateBoardWithoutEdges();
+    updateBoardEdges(upperGhostRow, lowerGhostRow);
+}
+
+void Engine::updateBoardOverlapped(
+    const std::function<bool(bool)> &receive_ghost_rows,
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    updateBoardWithoutEdges();
+    receive_ghost_rows(true);
+    updateBoardEdges(upperGhostRow, lowerGhostRow);
+}
+
+uint64_t Engine::hashBoard(const size_t first_index) const {
+    std::vector<Cell> row(width);
+    uint64_t hash = 0;
+    for (int y = 0; y < height; ++y) {
+        copyRow(y, row.data());
+        hash += hashCells(
+            row.data(),
+            width,
+            first_index + static_cast<size_t>(y) * width
+        );
+    }
+    return hash;
+}
+
+void Engine::updateBoardWithoutEdges() {
+    if (height > 2) {
+        updateBoardRows(1, height - 1);
+    }
+}
+
+void Engine::advance(const int generations) {
+    for (int generation = 0; generation < generations; ++generation) {
+        updateBoard(nullptr, nullptr);
+    }
+}
+
+// ScalarEngine
+
+ScalarEngine::ScalarEngine(
+    const Board &board,
+    const int start_row,
+    const int rows_number
+)
+    : Engine(board.getWidth(), rows_number),
+      board(Board::createSubBoard(board, start_row, rows_number)) {}
+
+void ScalarEngine::copyRow(const int y, Cell *out) const {
+    std::memcpy(out, board.getRow(y), sizeof(Cell) * width);
+}
+
+void ScalarEngine::copyBoard(Cell *out) const {
+    std::memcpy(out, board.getBoard(), sizeof(Cell) * board.getSize());
+}
+
+void ScalarEngine::printNumaReport(const int proc_id) const {
+    ::printNumaReport(
+        board.getBoard(),
+        sizeof(Cell) * width,
+        1,
+        height - 1,
+        proc_id
+    );
+}
+
+void ScalarEngine::updateBoard(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    board.updateBoard(upperGhostRow, lowerGhostRow);
+}
+
+void ScalarEngine::updateBoardRows(const int from, const int to) {
+    board.updateBoardRows(from, to);
+}
+
+void ScalarEngine::updateBoardEdges(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    board.updateBoardEdges(upperGhostRow, lowerGhostRow);
+}
+
+// Static
+
+std::unique_ptr<Engine> createEngine(
+    const EngineType type,
+    const Board &board,
+    const int start_row,
+    const int rows_number
+) {
+    switch (type) {
+        case VECTORIZED:
+            return std::make_unique<VectorizedEngine>(
+                board,
+                start_row,
+                rows_number
+            );
+        case BITPACKED:
+            return std::make_unique<BitpackedEngine>(
+                board,
+                start_row,
+                rows_number
+            );
+        case TILED:
+            return std::make_unique<TiledEngine>(
+                board,
+                start_row,
+                rows_number
+            );
+        case SPARSE:
+            return std::make_unique<SparseEngine>(
+                board,
+                start_row,
+                rows_number
+            );
+        case SCALAR:
+        default:
+            return std::make_unique<ScalarEngine>(
+                board,
+                start_row,
+                rows_number
+            );
+    }
+}
@@ -0,0 +1,202 @@
+#include "../include/engine.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../include/numa.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+constexpr int word_bits = 64;
+
+// Bitwise full adder, carry has twice the weight of sum
+inline void addBits(
+    const uint64_t a,
+    const uint64_t b,
+    const uint64_t c,
+    uint64_t &sum,
+    uint64_t &carry
+) {
+    const uint64_t partial = a ^ b;
+    sum = partial ^ c;
+    carry = (a & b) | (partial & c);
+}
+}  // namespace
+
+BitpackedEngine::BitpackedEngine(
+    const Board &board,
+    const int start_row,
+    const int rows_number
+)
+    : Engine(board.getWidth(), rows_number),
+      words_count((board.getWidth() + word_bits - 1) / word_bits),
+      stride(words_count + 2),
+      last_word_mask(
+          board.getWidth() % word_bits == 0
+              ? ~0ULL
+              : (1ULL << (board.getWidth() % word_bits)) - 1
+      ),
+      buffer_size(static_cast<size_t>(stride) * (rows_number + 2)),
+      board(static_cast<uint64_t *>(
+          allocateBoardMemory(sizeof(uint64_t) * buffer_size)
+      )),
+      new_board(static_cast<uint64_t *>(
+          allocateBoardMemory(sizeof(uint64_t) * buffer_size)
+      )) {
+    // Middle rows (buffer rows 2 to height - 1) are first touched by the
+    // threads updating them
+    for (uint64_t *buffer : {this->board, new_board}) {
+        firstTouchRows(
+            buffer,
+            sizeof(uint64_t) * stride,
+            height + 2,
+            2,
+            height
+        );
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        packRow(board.getRow(start_row + y), getRow(this->board, y));
+    }
+}
+
+BitpackedEngine::~BitpackedEngine() {
+    freeBoardMemory(board);
+    freeBoardMemory(new_board);
+}
+
+uint64_t *BitpackedEngine::getRow(uint64_t *buffer, const int y) const {
+    return &buffer[static_cast<size_t>(y + 1) * stride + 1];
+}
+
+void BitpackedEngine::packRow(const Cell *cells, uint64_t *words) const {
+    for (int i = 0; i < words_count; ++i) {
+        const int first = i * word_bits;
+        const int count = std::min(word_bits, width - first);
+        uint64_t word = 0;
+        for (int bit = 0; bit < count; ++bit) {
+            word |= static_cast<uint64_t>(cells[first + bit] == ALIVE) << bit;
+        }
+        words[i] = word;
+    }
+}
+
+void BitpackedEngine::unpackRow(const uint64_t *words, Cell *cells) const {
+    for (int x = 0; x < width; ++x) {
+        cells[x] = (words[x / word_bits] >> (x % word_bits)) & 1 ? ALIVE : DEAD;
+    }
+}
+
+void BitpackedEngine::copyRow(const int y, Cell *out) const {
+    unpackRow(getRow(board, y), out);
+}
+
+void BitpackedEngine::copyBoard(Cell *out) const {
+    for (int y = 0; y < height; ++y) {
+        copyRow(y, &out[static_cast<size_t>(y) * width]);
+    }
+}
+
+void BitpackedEngine::printNumaReport(const int proc_id) const {
+    // Buffer row 1 holds the first row of the strip
+    ::printNumaReport(
+        &board[stride],
+        sizeof(uint64_t) * stride,
+        1,
+        height - 1,
+        proc_id
+    );
+}
+
+inline void BitpackedEngine::updateRow(
+    const uint64_t *prevRow,
+    const uint64_t *currRow,
+    const uint64_t *nextRow,
+    uint64_t *newRow
+) const {
+    // Bit x holds column x, so the left neighbor of every cell is obtained by
+    // shifting left and carrying in the top bit of the previous word. Border
+    // words are always zero.
+    for (int i = 0; i < words_count; ++i) {
+        const uint64_t prev_left = (prevRow[i] << 1) | (prevRow[i - 1] >> 63);
+        const uint64_t prev_right = (prevRow[i] >> 1) | (prevRow[i + 1] << 63);
+        const uint64_t curr_left = (currRow[i] << 1) | (currRow[i - 1] >> 63);
+        const uint64_t curr_right = (currRow[i] >> 1) | (currRow[i + 1] << 63);
+        const uint64_t next_left = (nextRow[i] << 1) | (nextRow[i - 1] >> 63);
+        const uint64_t next_right = (nextRow[i] >> 1) | (nextRow[i + 1] << 63);
+
+        // Sum of the 8 neighbors as ones and twos bits, fours is set for any
+        // count of at least 4
+        uint64_t sum_a, carry_a, sum_b, carry_b;
+        addBits(prev_left, prevRow[i], prev_right, sum_a, carry_a);
+        addBits(next_left, nextRow[i], next_right, sum_b, carry_b);
+        const uint64_t sum_c = curr_left ^ curr_right;
+        const uint64_t carry_c = curr_left & curr_right;
+
+        uint64_t ones, carry_d;
+        addBits(sum_a, sum_b, sum_c, ones, carry_d);
+
+        uint64_t twos_partial, fours_a;
+        addBits(carry_a, carry_b, carry_c, twos_partial, fours_a);
+        const uint64_t twos = twos_partial ^ carry_d;
+        const uint64_t fours = fours_a | (twos_partial & carry_d);
+
+        // Alive with 3 neighbors, or alive and 2 neighbors
+        newRow[i] = ~fours & twos & (ones | currRow[i]);
+    }
+    newRow[words_count - 1] &= last_word_mask;
+}
+
+void BitpackedEngine::updateBoardRows(const int from, const int to) {
+#pragma omp parallel for schedule(static)
+    for (int y = from; y < to; ++y) {
+        updateRow(
+            getRow(board, y - 1),
+            getRow(board, y),
+            getRow(board, y + 1),
+            getRow(new_board, y)
+        );
+    }
+}
+
+void BitpackedEngine::updateBoardEdges(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    // Ghost rows
+    uint64_t *upper_row = getRow(board, -1);
+    uint64_t *lower_row = getRow(board, height);
+    for (int i = 0; i < words_count; ++i) {
+        upper_row[i] = 0;
+        lower_row[i] = 0;
+    }
+    if (upperGhostRow) {
+        packRow(upperGhostRow, upper_row);
+    }
+    if (lowerGhostRow) {
+        packRow(lowerGhostRow, lower_row);
+    }
+
+    // first row
+    updateRow(
+        getRow(board, -1),
+        getRow(board, 0),
+        getRow(board, 1),
+        getRow(new_board, 0)
+    );
+
+    // last row
+    if (height > 1) {
+        updateRow(
+            getRow(board, height - 2),
+            getRow(board, height - 1),
+            getRow(board, height),
+            getRow(new_board, height - 1)
+        );
+    }
+
+    std::swap(board, new_board);
+}
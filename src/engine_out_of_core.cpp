@@ -0,0 +1,205 @@
+#include "../include/engine.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include "../include/numa.hpp"
+
+// OutOfCoreEngine
+
+OutOfCoreEngine::OutOfCoreEngine(
+    const std::string &directory,
+    const int width,
+    const int height,
+    const BoardInitType type,
+    const size_t band_bytes
+)
+    : VectorizedEngine(width, height),
+      band_rows(std::clamp<size_t>(
+          band_bytes / (width + 2),
+          1,
+          height
+      )),
+      band(nullptr),
+      new_band(nullptr) {
+    try {
+        board = mapScratchFile(directory);
+        new_board = mapScratchFile(directory);
+
+        const size_t band_size =
+            static_cast<size_t>(stride) *
+            (band_rows + 2 * max_pass_generations + 2);
+        band = static_cast<uint8_t *>(allocateBoardMemory(band_size));
+        new_band = static_cast<uint8_t *>(allocateBoardMemory(band_size));
+    } catch (...) {
+        releaseMemory();
+        throw;
+    }
+
+    // Board holds two Cell buffers, its bands are smaller to take about as
+    // much memory as a byte band
+    const int init_rows =
+        std::max(1, band_rows / static_cast<int>(2 * sizeof(Cell)));
+    for (int first = 0; first < height; first += init_rows) {
+        const int rows = std::min(init_rows, height - first);
+        Board init_board(width, rows);
+        init_board.Init(type, first, height);
+        for (int y = 0; y < rows; ++y) {
+            const Cell *source = init_board.getRow(y);
+            uint8_t *row = getRow(board, first + y);
+            for (int x = 0; x < width; ++x) {
+                row[x] = source[x] == ALIVE ? 1 : 0;
+            }
+        }
+    }
+}
+
+OutOfCoreEngine::~OutOfCoreEngine() { releaseMemory(); }
+
+void OutOfCoreEngine::releaseMemory() {
+    for (uint8_t *map : {board, new_board}) {
+        if (map) {
+            munmap(map, buffer_size);
+        }
+    }
+    // Nothing left for VectorizedEngine to free
+    board = nullptr;
+    new_board = nullptr;
+    freeBoardMemory(band);
+    freeBoardMemory(new_band);
+    band = nullptr;
+    new_band = nullptr;
+}
+
+uint8_t *OutOfCoreEngine::mapScratchFile(const std::string &directory) const {
+    std::string path = directory + "/board_XXXXXX";
+    const int fd = mkstemp(path.data());
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+    unlink(path.c_str());
+
+    // Extended file reads as zeros, border rows and columns stay dead
+    if (ftruncate(fd, static_cast<off_t>(buffer_size)) == -1) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    void *data = mmap(
+        nullptr,
+        buffer_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0
+    );
+    const int error = errno;
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+    // Passes read and write the files front to back
+    madvise(data, buffer_size, MADV_SEQUENTIAL);
+    return static_cast<uint8_t *>(data);
+}
+
+void OutOfCoreEngine::adviseRows(
+    uint8_t *buffer,
+    const int from,
+    const int to,
+    const int advice
+) const {
+    if (from >= to) {
+        return;
+    }
+    // madvise requires a page aligned start
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t begin = static_cast<size_t>(from + 1) * stride;
+    const size_t end = static_cast<size_t>(to + 1) * stride;
+    const size_t aligned_begin = begin / page_size * page_size;
+    madvise(&buffer[aligned_begin], end - aligned_begin, advice);
+}
+
+void OutOfCoreEngine::advance(const int generations) {
+    for (int done = 0; done < generations; done += max_pass_generations) {
+        advancePass(std::min(max_pass_generations, generations - done));
+    }
+}
+
+void OutOfCoreEngine::advancePass(const int generations) {
+    // Ghost rows may hold rows of updateBoardEdges, advance has dead ones
+    std::memset(board, 0, stride);
+    std::memset(getRow(board, height) - 1, 0, stride);
+
+    for (int band_start = 0; band_start < height; band_start += band_rows) {
+        const int band_end = std::min(band_start + band_rows, height);
+        // Rows the band depends on over the generations
+        const int first = std::max(0, band_start - generations);
+        const int last = std::min(height, band_end + generations);
+
+        // Read ahead the rows of the next band while this one is computed
+        adviseRows(
+            board,
+            last,
+            std::min(height, band_end + band_rows + generations),
+            MADV_WILLNEED
+        );
+
+        // Rows [first - 1, last] including the dead ghost rows. Band row y
+        // is getRow(band, y - first).
+        const size_t band_bytes =
+            static_cast<size_t>(last - first + 2) * stride;
+        std::memcpy(band, getRow(board, first - 1) - 1, band_bytes);
+        std::memcpy(new_band, band, band_bytes);
+
+        // Every generation the rows next to a margin lose their neighbors,
+        // the board edges have dead ones
+        int from = first;
+        int to = last;
+        for (int generation = 0; generation < generations; ++generation) {
+            if (first > 0) {
+                ++from;
+            }
+            if (last < height) {
+                --to;
+            }
+#pragma omp parallel for schedule(static)
+            for (int y = from; y < to; ++y) {
+                updateRow(
+                    getRow(band, y - first - 1),
+                    getRow(band, y - first),
+                    getRow(band, y - first + 1),
+                    getRow(new_band, y - first),
+                    width
+                );
+            }
+            std::swap(band, new_band);
+        }
+
+        std::memcpy(
+            getRow(new_board, band_start) - 1,
+            getRow(band, band_start - first) - 1,
+            static_cast<size_t>(band_end - band_start) * stride
+        );
+
+        // Written rows and the source rows behind the next band are no longer
+        // needed in memory, the page cache writes them back
+        adviseRows(new_board, band_start, band_end, MADV_DONTNEED);
+        adviseRows(
+            board,
+            std::max(0, band_start - generations),
+            std::max(0, band_end - generations),
+            MADV_DONTNEED
+        );
+    }
+
+    std::swap(board, new_board);
+}
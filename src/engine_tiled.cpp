@@ -0,0 +1,213 @@
+#include "../include/engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+TiledEngine::TiledEngine(
+    const Board &board,
+    const int start_row,
+    const int rows_number
+)
+    : VectorizedEngine(board, start_row, rows_number),
+      tile_rows_count((rows_number + tile_rows - 1) / tile_rows),
+      tile_columns_count((board.getWidth() + tile_columns - 1) / tile_columns),
+      neighbor_tiles(tile_rows_count * tile_columns_count),
+      scheduler(WorkStealingScheduler::defaultThreadsCount()) {
+    for (int tile_y = 0; tile_y < tile_rows_count; ++tile_y) {
+        for (int tile_x = 0; tile_x < tile_columns_count; ++tile_x) {
+            std::vector<int> &neighbors =
+                neighbor_tiles[tile_y * tile_columns_count + tile_x];
+            for (int y = std::max(0, tile_y - 1);
+                 y <= std::min(tile_rows_count - 1, tile_y + 1);
+                 ++y) {
+                for (int x = std::max(0, tile_x - 1);
+                     x <= std::min(tile_columns_count - 1, tile_x + 1);
+                     ++x) {
+                    neighbors.push_back(y * tile_columns_count + x);
+                }
+            }
+        }
+    }
+}
+
+void TiledEngine::updateTile(
+    uint8_t *source,
+    uint8_t *destination,
+    const int from,
+    const int to,
+    const int first_column,
+    const int last_column
+) const {
+    for (int y = from; y < to; ++y) {
+        updateRow(
+            getRow(source, y - 1) + first_column,
+            getRow(source, y) + first_column,
+            getRow(source, y + 1) + first_column,
+            getRow(destination, y) + first_column,
+            last_column - first_column
+        );
+    }
+}
+
+void TiledEngine::updateRows(const int from, const int to) {
+    // Edge rows are not worth waking up the workers, they are updated on the
+    // calling thread rather than by another thread pool
+    if (to - from < tile_rows) {
+        updateTile(board, new_board, from, to, 0, width);
+        return;
+    }
+
+    const int bands_count = (to - from + tile_rows - 1) / tile_rows;
+    std::vector<int> tiles(bands_count * tile_columns_count);
+    std::iota(tiles.begin(), tiles.end(), 0);
+
+    scheduler.run(tiles, [&](const int tile) {
+        const int first_row = from + tile / tile_columns_count * tile_rows;
+        const int first_column = tile % tile_columns_count * tile_columns;
+        updateTile(
+            board,
+            new_board,
+            first_row,
+            std::min(to, first_row + tile_rows),
+            first_column,
+            std::min(width, first_column + tile_columns)
+        );
+    });
+}
+
+void TiledEngine::updateBoardOverlapped(
+    const std::function<bool(bool)> &receive_ghost_rows,
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    // Interior tiles cover rows [1, height - 1), the two tasks after them are
+    // the edge rows
+    const int bands_count =
+        (std::max(0, height - 2) + tile_rows - 1) / tile_rows;
+    const int interior_tiles_count = bands_count * tile_columns_count;
+    const int upper_edge = interior_tiles_count;
+    // A single row is both edges
+    const int edges_end = upper_edge + (height > 1 ? 2 : 1);
+    const auto updateEdgeRow = [&](const int edge) {
+        const int y = edge == upper_edge ? 0 : height - 1;
+        updateTile(board, new_board, y, y + 1, 0, width);
+    };
+
+    // Only the calling thread receives, so only it reads the flag
+    bool received = false;
+
+    std::vector<int> tiles(interior_tiles_count);
+    std::iota(tiles.begin(), tiles.end(), 0);
+
+    scheduler.run(tiles, [&](const int tile) {
+        if (tile >= upper_edge) {
+            updateEdgeRow(tile);
+            return;
+        }
+
+        const int first_row = 1 + tile / tile_columns_count * tile_rows;
+        const int first_column = tile % tile_columns_count * tile_columns;
+        updateTile(
+            board,
+            new_board,
+            first_row,
+            std::min(height - 1, first_row + tile_rows),
+            first_column,
+            std::min(width, first_column + tile_columns)
+        );
+
+        // Ghost rows are only read by the edge rows, so they are set while
+        // the other workers update the interior
+        if (WorkStealingScheduler::currentWorkerId() == 0 && !received &&
+            receive_ghost_rows(false)) {
+            received = true;
+            setGhostRows(upperGhostRow, lowerGhostRow);
+            for (int edge = upper_edge; edge < edges_end; ++edge) {
+                scheduler.spawn(edge);
+            }
+        }
+    });
+
+    // The interior finished first
+    if (!received) {
+        receive_ghost_rows(true);
+        setGhostRows(upperGhostRow, lowerGhostRow);
+        for (int edge = upper_edge; edge < edges_end; ++edge) {
+            updateEdgeRow(edge);
+        }
+    }
+
+    std::swap(board, new_board);
+}
+
+void TiledEngine::advance(const int generations) {
+    if (generations <= 0) {
+        return;
+    }
+
+    // Ghost rows of both buffers stay dead
+    uint8_t *buffers[2] = {board, new_board};
+    for (uint8_t *buffer : buffers) {
+        std::memset(getRow(buffer, -1), 0, width);
+        std::memset(getRow(buffer, height), 0, width);
+    }
+
+    const int tiles_count = static_cast<int>(neighbor_tiles.size());
+    // Generation g of a tile reads buffers[(g - 1) % 2] and writes
+    // buffers[g % 2]. Writing is safe once every neighbor finished
+    // generation g - 1, as they no longer read what is overwritten.
+    std::vector<int> tile_generations(tiles_count, 0);
+    // Neighbors that still have to finish the generation before, indexed by
+    // tile and parity of the generation
+    std::unique_ptr<std::atomic<int>[]> remaining_neighbors(
+        new std::atomic<int>[2 * tiles_count]
+    );
+    for (int tile = 0; tile < tiles_count; ++tile) {
+        const int neighbors_count =
+            static_cast<int>(neighbor_tiles[tile].size());
+        remaining_neighbors[2 * tile].store(neighbors_count);
+        remaining_neighbors[2 * tile + 1].store(neighbors_count);
+    }
+
+    std::vector<int> tiles(tiles_count);
+    std::iota(tiles.begin(), tiles.end(), 0);
+
+    scheduler.run(tiles, [&](const int tile) {
+        const int generation = ++tile_generations[tile];
+        // Counter of this generation is reused two generations later, its
+        // neighbors can not get there before this tile finishes
+        remaining_neighbors[2 * tile + generation % 2].store(
+            static_cast<int>(neighbor_tiles[tile].size()),
+            std::memory_order_release
+        );
+
+        const int first_row = tile / tile_columns_count * tile_rows;
+        const int first_column = tile % tile_columns_count * tile_columns;
+        updateTile(
+            buffers[(generation - 1) % 2],
+            buffers[generation % 2],
+            first_row,
+            std::min(height, first_row + tile_rows),
+            first_column,
+            std::min(width, first_column + tile_columns)
+        );
+
+        if (generation == generations) {
+            return;
+        }
+        for (const int neighbor : neighbor_tiles[tile]) {
+            std::atomic<int> &remaining =
+                remaining_neighbors[2 * neighbor + (generation + 1) % 2];
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                scheduler.spawn(neighbor);
+            }
+        }
+    });
+
+    if (generations % 2 == 1) {
+        std::swap(board, new_board);
+    }
+}
@@ -0,0 +1,221 @@
+#include "../include/engine.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include "../include/numa.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// VectorizedEngine
+
+VectorizedEngine::VectorizedEngine(
+    const Board &board,
+    const int start_row,
+    const int rows_number
+)
+    : Engine(board.getWidth(), rows_number),
+      stride(board.getWidth() + 2),
+      buffer_size(static_cast<size_t>(stride) * (rows_number + 2)),
+      board(static_cast<uint8_t *>(
+          allocateBoardMemory(sizeof(uint8_t) * buffer_size)
+      )),
+      new_board(static_cast<uint8_t *>(
+          allocateBoardMemory(sizeof(uint8_t) * buffer_size)
+      )) {
+    // Middle rows (buffer rows 2 to height - 1) are first touched by the
+    // threads updating them
+    for (uint8_t *buffer : {this->board, new_board}) {
+        firstTouchRows(
+            buffer,
+            sizeof(uint8_t) * stride,
+            height + 2,
+            2,
+            height
+        );
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const Cell *source = board.getRow(start_row + y);
+        uint8_t *row = getRow(this->board, y);
+        for (int x = 0; x < width; ++x) {
+            row[x] = source[x] == ALIVE ? 1 : 0;
+        }
+    }
+}
+
+VectorizedEngine::VectorizedEngine(const int width, const int height)
+    : Engine(width, height),
+      stride(width + 2),
+      buffer_size(static_cast<size_t>(stride) * (height + 2)),
+      board(nullptr),
+      new_board(nullptr) {}
+
+VectorizedEngine::~VectorizedEngine() {
+    freeBoardMemory(board);
+    freeBoardMemory(new_board);
+}
+
+uint8_t *VectorizedEngine::getRow(uint8_t *buffer, const int y) const {
+    return &buffer[static_cast<size_t>(y + 1) * stride + 1];
+}
+
+void VectorizedEngine::copyRow(const int y, Cell *out) const {
+    const uint8_t *row = getRow(board, y);
+    for (int x = 0; x < width; ++x) {
+        out[x] = row[x] ? ALIVE : DEAD;
+    }
+}
+
+void VectorizedEngine::copyBoard(Cell *out) const {
+    for (int y = 0; y < height; ++y) {
+        copyRow(y, &out[static_cast<size_t>(y) * width]);
+    }
+}
+
+void VectorizedEngine::printNumaReport(const int proc_id) const {
+    // Buffer row 1 holds the first row of the strip
+    ::printNumaReport(
+        &board[stride],
+        sizeof(uint8_t) * stride,
+        1,
+        height - 1,
+        proc_id
+    );
+}
+
+void VectorizedEngine::updateRow(
+    const uint8_t *prevRow,
+    const uint8_t *currRow,
+    const uint8_t *nextRow,
+    uint8_t *newRow,
+    const int width
+) {
+    // Border columns are always dead, so x - 1 and x + 1 are safe
+#pragma omp simd
+    for (int x = 0; x < width; ++x) {
+        const uint8_t neighbors = prevRow[x - 1] + prevRow[x] + prevRow[x + 1] +
+                                  currRow[x - 1] + currRow[x + 1] +
+                                  nextRow[x - 1] + nextRow[x] + nextRow[x + 1];
+        newRow[x] = (neighbors == 3) | (currRow[x] & (neighbors == 2));
+    }
+}
+
+void VectorizedEngine::updateRows(const int from, const int to) {
+#pragma omp parallel for schedule(static)
+    for (int y = from; y < to; ++y) {
+        updateRow(
+            getRow(board, y - 1),
+            getRow(board, y),
+            getRow(board, y + 1),
+            getRow(new_board, y),
+            width
+        );
+    }
+}
+
+void VectorizedEngine::updateBoardRows(const int from, const int to) {
+    updateRows(from, to);
+}
+
+void VectorizedEngine::updateBoardEdges(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    setGhostRows(upperGhostRow, lowerGhostRow);
+
+    // first row
+    updateRows(0, 1);
+
+    // last row
+    if (height > 1) {
+        updateRows(height - 1, height);
+    }
+
+    std::swap(board, new_board);
+}
+
+void VectorizedEngine::setGhostRows(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    uint8_t *upper_row = getRow(board, -1);
+    uint8_t *lower_row = getRow(board, height);
+    for (int x = 0; x < width; ++x) {
+        upper_row[x] = upperGhostRow && upperGhostRow[x] == ALIVE ? 1 : 0;
+        lower_row[x] = lowerGhostRow && lowerGhostRow[x] == ALIVE ? 1 : 0;
+    }
+    onGhostRowsSet();
+}
+
+// SparseEngine
+
+SparseEngine::SparseEngine(
+    const Board &board,
+    const int start_row,
+    const int rows_number
+)
+    : VectorizedEngine(board, start_row, rows_number),
+      alive_rows(rows_number + 2, 0),
+      new_alive_rows(rows_number + 2, 0) {
+    for (int y = 0; y < height; ++y) {
+        const uint8_t *row = getRow(this->board, y);
+        for (int x = 0; x < width && !alive_rows[y + 1]; ++x) {
+            alive_rows[y + 1] = row[x];
+        }
+    }
+}
+
+void SparseEngine::updateRows(const int from, const int to) {
+#pragma omp parallel for schedule(static)
+    for (int y = from; y < to; ++y) {
+        uint8_t *new_row = getRow(new_board, y);
+
+        // Dead neighborhood stays dead, the row only has to be cleared if it
+        // still holds cells from two generations ago
+        if (!(alive_rows[y] | alive_rows[y + 1] | alive_rows[y + 2])) {
+            if (new_alive_rows[y + 1]) {
+                std::memset(new_row, 0, width);
+                new_alive_rows[y + 1] = 0;
+            }
+            continue;
+        }
+
+        updateRow(
+            getRow(board, y - 1),
+            getRow(board, y),
+            getRow(board, y + 1),
+            new_row,
+            width
+        );
+
+        uint8_t alive = 0;
+#pragma omp simd reduction(| : alive)
+        for (int x = 0; x < width; ++x) {
+            alive |= new_row[x];
+        }
+        new_alive_rows[y + 1] = alive;
+    }
+}
+
+void SparseEngine::onGhostRowsSet() {
+    const uint8_t *upper_row = getRow(board, -1);
+    const uint8_t *lower_row = getRow(board, height);
+    uint8_t upper_alive = 0, lower_alive = 0;
+    for (int x = 0; x < width; ++x) {
+        upper_alive |= upper_row[x];
+        lower_alive |= lower_row[x];
+    }
+    alive_rows[0] = upper_alive;
+    alive_rows[height + 1] = lower_alive;
+}
+
+void SparseEngine::updateBoardEdges(
+    const Cell *upperGhostRow,
+    const Cell *lowerGhostRow
+) {
+    VectorizedEngine::updateBoardEdges(upperGhostRow, lowerGhostRow);
+    std::swap(alive_rows, new_alive_rows);
+}
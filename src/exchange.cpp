@@ -0,0 +1,285 @@
+#include "../include/exchange.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+#include "../include/wire.hpp"
+
+// Exchange
+
+Exchange::Exchange(const int proc_id, const int last_proc_id, const int width)
+    : proc_id(proc_id), last_proc_id(last_proc_id), width(width),
+      upper_ghost_row(new(std::align_val_t(64)) Cell[width]{}),
+      lower_ghost_row(new(std::align_val_t(64)) Cell[width]{}),
+      upper_edge_row(new(std::align_val_t(64)) Cell[width]{}),
+      lower_edge_row(new(std::align_val_t(64)) Cell[width]{}),
+      message_capacity(static_cast<int>(maxEncodedSize(width))),
+      upper_edge_message(message_capacity),
+      lower_edge_message(message_capacity),
+      upper_ghost_message(message_capacity),
+      lower_ghost_message(message_capacity) {}
+
+Exchange::~Exchange() {
+    operator delete[](upper_ghost_row, std::align_val_t(64));
+    operator delete[](lower_ghost_row, std::align_val_t(64));
+    operator delete[](upper_edge_row, std::align_val_t(64));
+    operator delete[](lower_edge_row, std::align_val_t(64));
+}
+
+bool Exchange::hasUpperNeighbor() const { return proc_id > 0; }
+
+bool Exchange::hasLowerNeighbor() const { return proc_id < last_proc_id; }
+
+const Cell *Exchange::getUpperGhostRow() const {
+    return hasUpperNeighbor() ? upper_ghost_row : nullptr;
+}
+
+const Cell *Exchange::getLowerGhostRow() const {
+    return hasLowerNeighbor() ? lower_ghost_row : nullptr;
+}
+
+int Exchange::packEdgeRow(
+    const Engine &engine,
+    const int y,
+    Cell *row,
+    std::vector<uint8_t> &message
+) const {
+    engine.copyRow(y, row);
+    return static_cast<int>(encodeCells(row, width, message.data()));
+}
+
+void Exchange::unpackGhostRows() {
+    if (hasUpperNeighbor()) {
+        decodeCells(upper_ghost_message.data(), width, upper_ghost_row);
+    }
+    if (hasLowerNeighbor()) {
+        decodeCells(lower_ghost_message.data(), width, lower_ghost_row);
+    }
+}
+
+void Exchange::postEdgeRows(const Engine &engine, MPI_Request requests[4]) {
+    requests[0] = MPI_REQUEST_NULL;
+    requests[1] = MPI_REQUEST_NULL;
+    requests[2] = MPI_REQUEST_NULL;
+    requests[3] = MPI_REQUEST_NULL;
+
+    // Non-blocking receive and send with the upper neighbor
+    if (hasUpperNeighbor()) {
+        const int size =
+            packEdgeRow(engine, 0, upper_edge_row, upper_edge_message);
+        MPI_Irecv(
+            upper_ghost_message.data(),
+            message_capacity,
+            MPI_BYTE,
+            proc_id - 1,
+            0,
+            MPI_COMM_WORLD,
+            &requests[0]
+        );
+        MPI_Isend(
+            upper_edge_message.data(),
+            size,
+            MPI_BYTE,
+            proc_id - 1,
+            1,
+            MPI_COMM_WORLD,
+            &requests[1]
+        );
+    }
+
+    // Non-blocking receive and send with the lower neighbor
+    if (hasLowerNeighbor()) {
+        const int size = packEdgeRow(
+            engine,
+            engine.getHeight() - 1,
+            lower_edge_row,
+            lower_edge_message
+        );
+        MPI_Irecv(
+            lower_ghost_message.data(),
+            message_capacity,
+            MPI_BYTE,
+            proc_id + 1,
+            1,
+            MPI_COMM_WORLD,
+            &requests[2]
+        );
+        MPI_Isend(
+            lower_edge_message.data(),
+            size,
+            MPI_BYTE,
+            proc_id + 1,
+            0,
+            MPI_COMM_WORLD,
+            &requests[3]
+        );
+    }
+}
+
+void Exchange::advance(Engine &engine, const int generations) {
+    for (int generation = 0; generation < generations; ++generation) {
+        step(engine);
+    }
+}
+
+// NoExchange
+
+void NoExchange::step(Engine &engine) {
+    engine.updateBoard(nullptr, nullptr);
+}
+
+void NoExchange::advance(Engine &engine, const int generations) {
+    engine.advance(generations);
+}
+
+// BlockingExchange
+
+void BlockingExchange::step(Engine &engine) {
+    int status = MPI_SUCCESS;
+    // Send and receive upper row
+    if (hasUpperNeighbor()) {
+        const int size =
+            packEdgeRow(engine, 0, upper_edge_row, upper_edge_message);
+        status = MPI_Sendrecv(
+            upper_edge_message.data(),
+            size,
+            MPI_BYTE,
+            proc_id - 1,
+            0,
+            upper_ghost_message.data(),
+            message_capacity,
+            MPI_BYTE,
+            proc_id - 1,
+            0,
+            MPI_COMM_WORLD,
+            MPI_STATUS_IGNORE
+        );
+    }
+    if (status != MPI_SUCCESS) {
+        std::cerr << "Error in UPPER row sync -> proc_id: " << proc_id
+                  << std::endl;
+    }
+
+    // Send and receive lower row
+    if (hasLowerNeighbor()) {
+        const int size = packEdgeRow(
+            engine,
+            engine.getHeight() - 1,
+            lower_edge_row,
+            lower_edge_message
+        );
+        status = MPI_Sendrecv(
+            lower_edge_message.data(),
+            size,
+            MPI_BYTE,
+            proc_id + 1,
+            0,
+            lower_ghost_message.data(),
+            message_capacity,
+            MPI_BYTE,
+            proc_id + 1,
+            0,
+            MPI_COMM_WORLD,
+            MPI_STATUS_IGNORE
+        );
+    }
+    if (status != MPI_SUCCESS) {
+        std::cerr << "Error in LOWER row sync -> proc_id: " << proc_id
+                  << std::endl;
+    }
+
+    unpackGhostRows();
+    engine.updateBoard(getUpperGhostRow(), getLowerGhostRow());
+}
+
+// OverlappedExchange
+
+void OverlappedExchange::step(Engine &engine) {
+    MPI_Request requests[4];
+    postEdgeRows(engine, requests);
+
+    // The engine updates the interior and the edge rows once the ghost rows
+    // arrive
+    engine.updateBoardOverlapped(
+        [this, &requests](const bool wait) {
+            int done = 1;
+            if (wait) {
+                MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+            } else {
+                MPI_Testall(4, requests, &done, MPI_STATUSES_IGNORE);
+            }
+            if (done) {
+                unpackGhostRows();
+            }
+            return done != 0;
+        },
+        getUpperGhostRow(),
+        getLowerGhostRow()
+    );
+}
+
+// CoroutineExchange
+
+void CoroutineExchange::step(Engine &engine) {
+    executor.run(stepGeneration(engine));
+}
+
+Task CoroutineExchange::stepGeneration(Engine &engine) {
+    MPI_Request requests[4];
+    postEdgeRows(engine, requests);
+
+    // Interior rows in bands, queued before awaiting the edge rows
+    const int height = engine.getHeight();
+    const int band_rows =
+        std::max(1, static_cast<int>(band_cells / std::max(width, 1)));
+    const int bands_count =
+        height > 2 ? (height - 2 + band_rows - 1) / band_rows : 0;
+    auto interior = executor.compute(
+        bands_count,
+        [&engine, height, band_rows](const int band) {
+            const int from = 1 + band * band_rows;
+            const int to = std::min(from + band_rows, height - 1);
+            engine.updateBoardRows(from, to);
+        }
+    );
+
+    co_await executor.wait(requests, 4);
+    unpackGhostRows();
+    co_await interior;
+
+    engine.updateBoardEdges(getUpperGhostRow(), getLowerGhostRow());
+}
+
+// Static
+
+std::unique_ptr<Exchange> createExchange(
+    const ExchangeType type,
+    const int proc_id,
+    const int last_proc_id,
+    const int width
+) {
+    switch (type) {
+        case NONE:
+            return std::make_unique<NoExchange>(proc_id, last_proc_id, width);
+        case BLOCKING:
+            return std::make_unique<BlockingExchange>(
+                proc_id,
+                last_proc_id,
+                width
+            );
+        case COROUTINE:
+            return std::make_unique<CoroutineExchange>(
+                proc_id,
+                last_proc_id,
+                width
+            );
+        case OVERLAPPED:
+        default:
+            return std::make_unique<OverlappedExchange>(
+                proc_id,
+                last_proc_id,
+                width
+            );
+    }
+}
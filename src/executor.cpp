@@ -0,0 +1,224 @@
+#include "../include/executor.hpp"
+
+#include <iostream>
+
+// Task
+
+Task::Task(const std::coroutine_handle<promise_type> handle)
+    : handle(handle) {}
+
+Task::Task(Task &&other) noexcept : handle(other.handle) {
+    other.handle = nullptr;
+}
+
+Task &Task::operator=(Task &&other) noexcept {
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Task::~Task() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+bool Task::isDone() const { return !handle || handle.done(); }
+
+// Executor::RequestsAwaiter
+
+Executor::RequestsAwaiter::RequestsAwaiter(
+    Executor &executor,
+    MPI_Request *requests,
+    const int count
+)
+    : executor(executor), requests(requests), count(count) {}
+
+bool Executor::RequestsAwaiter::await_ready() const {
+    for (int i = 0; i < count; ++i) {
+        if (requests[i] != MPI_REQUEST_NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Executor::RequestsAwaiter::await_suspend(
+    const std::coroutine_handle<> handle
+) {
+    waiting = handle;
+    for (int i = 0; i < count; ++i) {
+        if (requests[i] != MPI_REQUEST_NULL) {
+            executor.pending_requests.push_back(requests[i]);
+            executor.request_owners.emplace_back(this, i);
+            ++remaining;
+        }
+    }
+}
+
+// Executor::ComputeAwaiter
+
+Executor::ComputeAwaiter::ComputeAwaiter(std::shared_ptr<ComputeBatch> batch)
+    : batch(std::move(batch)) {}
+
+bool Executor::ComputeAwaiter::await_ready() const {
+    return batch->remaining == 0;
+}
+
+void Executor::ComputeAwaiter::await_suspend(
+    const std::coroutine_handle<> handle
+) {
+    batch->waiting = handle;
+}
+
+// Executor
+
+void Executor::spawn(Task task) {
+    std::erase_if(tasks, [](const Task &done) { return done.isDone(); });
+    ready.push_back(task.handle);
+    tasks.push_back(std::move(task));
+}
+
+void Executor::run(Task task) {
+    ready.push_back(task.handle);
+    runUntil([&task] { return task.isDone(); });
+}
+
+void Executor::drain() {
+    runUntil([this] { return isDone(); });
+    tasks.clear();
+}
+
+void Executor::waitFor(MPI_Request *requests, const int count) {
+    run(awaitRequests(requests, count));
+}
+
+void Executor::runUntil(const std::function<bool()> &done) {
+    while (true) {
+        resumeReady();
+        if (done()) {
+            break;
+        }
+
+        if (!batches.empty()) {
+            computeChunk();
+            poll(false);
+        } else if (!pending_requests.empty()) {
+            poll(true);
+        } else {
+            std::cerr << "Executor: every task waits, but nothing is pending"
+                      << std::endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+}
+
+Executor::RequestsAwaiter Executor::wait(
+    MPI_Request *requests,
+    const int count
+) {
+    return {*this, requests, count};
+}
+
+Executor::ComputeAwaiter Executor::compute(
+    const int chunks_count,
+    std::function<void(int)> execute
+) {
+    auto batch = std::make_shared<ComputeBatch>();
+    batch->execute = std::move(execute);
+    batch->chunks_count = chunks_count;
+    batch->remaining = chunks_count;
+    if (chunks_count > 0) {
+        batches.push_back(batch);
+    }
+    return ComputeAwaiter(std::move(batch));
+}
+
+bool Executor::isDone() const {
+    for (const Task &task : tasks) {
+        if (!task.isDone()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Task Executor::awaitRequests(MPI_Request *requests, const int count) {
+    co_await wait(requests, count);
+}
+
+void Executor::resumeReady() {
+    while (!ready.empty()) {
+        const std::coroutine_handle<> handle = ready.front();
+        ready.pop_front();
+        handle.resume();
+    }
+}
+
+void Executor::computeChunk() {
+    const std::shared_ptr<ComputeBatch> batch = batches.front();
+    const int chunk = batch->next_chunk++;
+    if (batch->next_chunk == batch->chunks_count) {
+        batches.pop_front();
+    }
+
+    batch->execute(chunk);
+
+    if (--batch->remaining == 0 && batch->waiting) {
+        ready.push_back(batch->waiting);
+    }
+}
+
+void Executor::poll(const bool block) {
+    if (pending_requests.empty()) {
+        return;
+    }
+
+    int completed_count = 0;
+    completed_indices.resize(pending_requests.size());
+    if (block) {
+        MPI_Waitsome(
+            static_cast<int>(pending_requests.size()),
+            pending_requests.data(),
+            &completed_count,
+            completed_indices.data(),
+            MPI_STATUSES_IGNORE
+        );
+    } else {
+        MPI_Testsome(
+            static_cast<int>(pending_requests.size()),
+            pending_requests.data(),
+            &completed_count,
+            completed_indices.data(),
+            MPI_STATUSES_IGNORE
+        );
+    }
+    if (completed_count == MPI_UNDEFINED || completed_count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < completed_count; ++i) {
+        auto [awaiter, index] = request_owners[completed_indices[i]];
+        awaiter->requests[index] = MPI_REQUEST_NULL;
+        if (--awaiter->remaining == 0) {
+            ready.push_back(awaiter->waiting);
+        }
+    }
+
+    // Drop the completed requests, MPI set them to MPI_REQUEST_NULL
+    size_t kept = 0;
+    for (size_t i = 0; i < pending_requests.size(); ++i) {
+        if (pending_requests[i] != MPI_REQUEST_NULL) {
+            pending_requests[kept] = pending_requests[i];
+            request_owners[kept] = request_owners[i];
+            ++kept;
+        }
+    }
+    pending_requests.resize(kept);
+    request_owners.resize(kept);
+}
@@ -0,0 +1,137 @@
+#include "../include/mpi_utils.hpp"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+size_t max_message_count = MAX_MESSAGE_COUNT;
+}  // namespace
+
+void setMaxMessageCount(const size_t count) {
+    max_message_count = std::clamp<size_t>(count, 1, MAX_MESSAGE_COUNT);
+}
+
+int chunksCount(const size_t count) {
+    return static_cast<int>(std::max<size_t>(
+        1,
+        (count + max_message_count - 1) / max_message_count
+    ));
+}
+
+int isendChunked(
+    const void *data,
+    const size_t count,
+    MPI_Datatype type,
+    const int dest,
+    const int tag,
+    MPI_Request *requests
+) {
+    int type_size;
+    MPI_Type_size(type, &type_size);
+
+    const char *bytes = static_cast<const char *>(data);
+    int status = MPI_SUCCESS;
+    for (int chunk = 0; chunk < chunksCount(count); ++chunk) {
+        const size_t first = static_cast<size_t>(chunk) * max_message_count;
+        const size_t chunk_count = std::min(max_message_count, count - first);
+        const int chunk_status = MPI_Isend(
+            bytes + first * type_size,
+            static_cast<int>(chunk_count),
+            type,
+            dest,
+            tag,
+            MPI_COMM_WORLD,
+            &requests[chunk]
+        );
+        if (chunk_status != MPI_SUCCESS) {
+            status = chunk_status;
+        }
+    }
+    return status;
+}
+
+int irecvChunked(
+    void *data,
+    const size_t count,
+    MPI_Datatype type,
+    const int source,
+    const int tag,
+    MPI_Request *requests
+) {
+    int type_size;
+    MPI_Type_size(type, &type_size);
+
+    char *bytes = static_cast<char *>(data);
+    int status = MPI_SUCCESS;
+    for (int chunk = 0; chunk < chunksCount(count); ++chunk) {
+        const size_t first = static_cast<size_t>(chunk) * max_message_count;
+        const size_t chunk_count = std::min(max_message_count, count - first);
+        const int chunk_status = MPI_Irecv(
+            bytes + first * type_size,
+            static_cast<int>(chunk_count),
+            type,
+            source,
+            tag,
+            MPI_COMM_WORLD,
+            &requests[chunk]
+        );
+        if (chunk_status != MPI_SUCCESS) {
+            status = chunk_status;
+        }
+    }
+    return status;
+}
+
+void getAffinitySlot(
+    const bool pins_threads,
+    int *slot,
+    int *slots_count
+) {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(
+        MPI_COMM_WORLD,
+        MPI_COMM_TYPE_SHARED,
+        0,
+        MPI_INFO_NULL,
+        &node_comm
+    );
+    int node_id, node_procs_count;
+    MPI_Comm_rank(node_comm, &node_id);
+    MPI_Comm_size(node_comm, &node_procs_count);
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(mask), &mask);
+    const int pins = pins_threads ? 1 : 0;
+
+    std::vector<cpu_set_t> masks(node_procs_count);
+    std::vector<int> pinning(node_procs_count);
+    MPI_Allgather(
+        &mask,
+        sizeof(mask),
+        MPI_BYTE,
+        masks.data(),
+        sizeof(mask),
+        MPI_BYTE,
+        node_comm
+    );
+    MPI_Allgather(&pins, 1, MPI_INT, pinning.data(), 1, MPI_INT, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    *slot = 0;
+    *slots_count = 0;
+    for (int i = 0; i < node_procs_count; ++i) {
+        if (!pinning[i] || !CPU_EQUAL(&masks[i], &mask)) {
+            continue;
+        }
+        if (i < node_id) {
+            ++*slot;
+        }
+        ++*slots_count;
+    }
+    if (!pins_threads) {
+        *slot = 0;
+    }
+}
@@ -0,0 +1,203 @@
+#include "../include/numa.hpp"
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../include/utils.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+constexpr size_t cache_line_size = 64;
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+// Pages of every thread sampled by the report
+constexpr int sampled_pages_count = 64;
+
+bool huge_pages = false;
+// CPU of every OpenMP thread, empty unless pinThreads pinned them
+std::vector<int> thread_cpus;
+
+int getThreadsCount() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+int getThreadId() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+}  // namespace
+
+void setHugePages(const bool enabled) { huge_pages = enabled; }
+
+void *allocateBoardMemory(const size_t bytes) {
+    const size_t alignment = huge_pages ? huge_page_size : cache_line_size;
+    // aligned_alloc requires a multiple of the alignment
+    const size_t size = std::max<size_t>(
+        alignment,
+        (bytes + alignment - 1) / alignment * alignment
+    );
+    void *data = std::aligned_alloc(alignment, size);
+    if (!data) {
+        throw std::bad_alloc();
+    }
+    if (huge_pages) {
+        madvise(data, size, MADV_HUGEPAGE);
+    }
+    return data;
+}
+
+void freeBoardMemory(void *data) { std::free(data); }
+
+void firstTouchRows(
+    void *data,
+    const size_t row_bytes,
+    const int rows_count,
+    const int parallel_first,
+    const int parallel_last
+) {
+    char *bytes = static_cast<char *>(data);
+
+#pragma omp parallel for schedule(static)
+    for (int row = parallel_first; row < parallel_last; ++row) {
+        std::memset(bytes + row * row_bytes, 0, row_bytes);
+    }
+
+    for (int row = 0; row < rows_count; ++row) {
+        if (row < parallel_first || row >= parallel_last) {
+            std::memset(bytes + row * row_bytes, 0, row_bytes);
+        }
+    }
+}
+
+void pinThreads(const int slot, const int slots_count) {
+#ifdef _OPENMP
+    if (std::getenv("OMP_PROC_BIND")) {
+        return;
+    }
+
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        return;
+    }
+    const size_t part_size =
+        std::max<size_t>(1, cpus.size() / std::max(1, slots_count));
+    const size_t part_first = slot * part_size % cpus.size();
+    thread_cpus.resize(getThreadsCount());
+    for (size_t thread = 0; thread < thread_cpus.size(); ++thread) {
+        const size_t cpu = part_first + thread % part_size;
+        thread_cpus[thread] = cpus[cpu % cpus.size()];
+    }
+
+#pragma omp parallel
+    pinCurrentThread(getThreadId());
+#endif
+}
+
+void pinCurrentThread(const int thread_id) {
+    if (thread_cpus.empty()) {
+        return;
+    }
+    cpu_set_t thread_cpu;
+    CPU_ZERO(&thread_cpu);
+    CPU_SET(thread_cpus[thread_id % thread_cpus.size()], &thread_cpu);
+    sched_setaffinity(0, sizeof(thread_cpu), &thread_cpu);
+}
+
+void printNumaReport(
+    const void *data,
+    const size_t row_bytes,
+    const int parallel_first,
+    const int parallel_last,
+    const int proc_id
+) {
+    const int threads_count = getThreadsCount();
+    const long page_size = sysconf(_SC_PAGESIZE);
+
+    // Rows of every thread, schedule(static) splits them like partitionRows
+    std::vector<int> start_rows(threads_count), num_rows(threads_count);
+    partitionRows(
+        std::max(0, parallel_last - parallel_first),
+        threads_count,
+        start_rows.data(),
+        num_rows.data()
+    );
+    std::vector<std::string> lines(threads_count);
+
+#pragma omp parallel num_threads(threads_count)
+    {
+        const int thread_id = getThreadId();
+        unsigned int cpu = 0, node = 0;
+        getcpu(&cpu, &node);
+
+        // Nodes of pages sampled evenly from the rows of the thread
+        const char *first =
+            static_cast<const char *>(data) +
+            (parallel_first + start_rows[thread_id]) * row_bytes;
+        const size_t bytes = num_rows[thread_id] * row_bytes;
+        const size_t pages_count = (bytes + page_size - 1) / page_size;
+        const size_t sampled_count =
+            std::min<size_t>(sampled_pages_count, pages_count);
+
+        std::vector<void *> pages(sampled_count);
+        std::vector<int> nodes(sampled_count, -1);
+        for (size_t i = 0; i < sampled_count; ++i) {
+            const size_t page = i * pages_count / sampled_count;
+            pages[i] = const_cast<char *>(first) + page * page_size;
+        }
+        if (sampled_count > 0) {
+            syscall(
+                SYS_move_pages,
+                0,
+                sampled_count,
+                pages.data(),
+                nullptr,
+                nodes.data(),
+                0
+            );
+        }
+        const long local_count = std::count(
+            nodes.begin(),
+            nodes.end(),
+            static_cast<int>(node)
+        );
+
+        std::ostringstream line;
+        line << "NUMA: process " << proc_id << " thread " << thread_id
+             << " cpu " << cpu << " node " << node << " rows ["
+             << parallel_first + start_rows[thread_id] << ", "
+             << parallel_first + start_rows[thread_id] + num_rows[thread_id]
+             << ") local pages " << local_count << "/" << sampled_count;
+        lines[thread_id] = line.str();
+    }
+
+    for (const std::string &line : lines) {
+        std::cout << line << "\n";
+    }
+    std::cout << std::flush;
+}
@@ -0,0 +1,156 @@
+#include "../include/scheduler.hpp"
+
+#include <sched.h>
+
+#include <algorithm>
+
+#include "../include/numa.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+// Worker id of the calling thread, -1 outside of the scheduler
+thread_local int current_worker_id = -1;
+}  // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(const int threads_count) {
+    const int count = std::max(1, threads_count);
+    for (int i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 1; i < count; ++i) {
+        threads.emplace_back(&WorkStealingScheduler::workerLoop, this, i);
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(run_mutex);
+        stopping = true;
+    }
+    run_started.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+int WorkStealingScheduler::getThreadsCount() const {
+    return static_cast<int>(workers.size());
+}
+
+int WorkStealingScheduler::defaultThreadsCount() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return 1;
+    }
+    return std::max(1, CPU_COUNT(&allowed));
+#endif
+}
+
+int WorkStealingScheduler::currentWorkerId() { return current_worker_id; }
+
+void WorkStealingScheduler::run(
+    const std::vector<int> &tasks,
+    const std::function<void(int)> &execute
+) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    // Initial tasks are dealt to the workers in turns
+    this->execute = &execute;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        Worker &worker = *workers[i % workers.size()];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(tasks[i]);
+    }
+    pending_tasks.store(static_cast<long>(tasks.size()));
+
+    {
+        std::lock_guard<std::mutex> lock(run_mutex);
+        ++run_id;
+    }
+    run_started.notify_all();
+
+    current_worker_id = 0;
+    work(0);
+    current_worker_id = -1;
+
+    // Helpers may still be leaving work(), execute must outlive them
+    while (active_workers.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+void WorkStealingScheduler::spawn(const int task) {
+    pending_tasks.fetch_add(1);
+    Worker &worker = *workers[current_worker_id];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(task);
+}
+
+void WorkStealingScheduler::workerLoop(const int worker_id) {
+    current_worker_id = worker_id;
+    // The thread inherits the mask of the creating thread, which pinThreads
+    // may have pinned to a single CPU
+    pinCurrentThread(worker_id);
+    long last_run_id = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(run_mutex);
+            run_started.wait(lock, [&] {
+                return stopping || run_id != last_run_id;
+            });
+            if (stopping) {
+                return;
+            }
+            last_run_id = run_id;
+            active_workers.fetch_add(1);
+        }
+
+        work(worker_id);
+        active_workers.fetch_sub(1);
+    }
+}
+
+void WorkStealingScheduler::work(const int worker_id) {
+    while (pending_tasks.load() > 0) {
+        int task;
+        if (pop(worker_id, task) || steal(worker_id, task)) {
+            (*execute)(task);
+            pending_tasks.fetch_sub(1);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WorkStealingScheduler::pop(const int worker_id, int &task) {
+    Worker &worker = *workers[worker_id];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = worker.tasks.back();
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingScheduler::steal(const int worker_id, int &task) {
+    const int workers_count = static_cast<int>(workers.size());
+    for (int i = 1; i < workers_count; ++i) {
+        Worker &victim = *workers[(worker_id + i) % workers_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,340 @@
+#include "../include/snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../include/mpi_utils.hpp"
+#include "../include/wire.hpp"
+
+// Pixels of the saved snapshots, the first rows of the strips but the first
+// one are gray to show the split between the workers
+static constexpr uint8_t alive_pixel = 255;
+static constexpr uint8_t dead_pixel = 0;
+static constexpr uint8_t edge_dead_pixel = 69;
+
+// Cells of a band of the initial board set at once
+static constexpr size_t init_band_cells = 1 << 20;
+
+// Requests of a snapshot of count cells: the header, then the chunks of the
+// encoded strip
+static int requestsCount(const size_t count) {
+    return 1 + chunksCount(maxEncodedSize(count));
+}
+
+// Initial board as pixels, set band by band so its cells never exist as a
+// whole
+static PGM initialPGM(const int board_size, const BoardInitType init_type) {
+    PGM pgm{
+        board_size,
+        board_size,
+        new u_int8_t[static_cast<size_t>(board_size) * board_size]
+    };
+    const int band_rows = static_cast<int>(std::clamp<size_t>(
+        init_band_cells / board_size,
+        1,
+        board_size
+    ));
+    for (int first = 0; first < board_size; first += band_rows) {
+        const int rows = std::min(band_rows, board_size - first);
+        Board band(board_size, rows);
+        band.Init(init_type, first, board_size);
+        const Cell *cells = band.getBoard();
+        uint8_t *pixels = &pgm.data[static_cast<size_t>(first) * board_size];
+        for (size_t i = 0; i < band.getSize(); ++i) {
+            pixels[i] = cells[i] == ALIVE ? alive_pixel : dead_pixel;
+        }
+    }
+    return pgm;
+}
+
+SnapshotSender::SnapshotSender(
+    const int collector_id,
+    const size_t cells_count,
+    const SnapshotPolicy policy,
+    Executor *executor
+)
+    : collector_id(collector_id), cells_count(cells_count), policy(policy),
+      executor(executor) {
+    for (int i = 0; i < buffers_count; ++i) {
+        buffers[i].resize(sizeof(SnapshotHeader) + maxEncodedSize(cells_count));
+        requests[i].assign(requestsCount(cells_count), MPI_REQUEST_NULL);
+    }
+}
+
+bool SnapshotSender::send(
+    const Engine &engine,
+    const int generation,
+    const bool force
+) {
+    // Buffers are sent in turns, so the next one is the oldest in flight
+    std::vector<MPI_Request> &buffer_requests = requests[next_buffer];
+    int done;
+    if (executor) {
+        // Requests are completed by the task awaiting them
+        done = isBufferFree(next_buffer);
+    } else {
+        MPI_Testall(
+            static_cast<int>(buffer_requests.size()),
+            buffer_requests.data(),
+            &done,
+            MPI_STATUSES_IGNORE
+        );
+    }
+
+    if (!done) {
+        if (policy == DROP && !force) {
+            ++dropped_count;
+            return false;
+        }
+        if (executor) {
+            const int buffer = next_buffer;
+            executor->runUntil([this, buffer] {
+                return isBufferFree(buffer);
+            });
+        } else {
+            MPI_Waitall(
+                static_cast<int>(buffer_requests.size()),
+                buffer_requests.data(),
+                MPI_STATUSES_IGNORE
+            );
+        }
+    }
+
+    // Encoded row by row, the strip is never copied out of the engine whole
+    uint8_t *buffer = buffers[next_buffer].data();
+    SnapshotHeader header{};
+    header.generation = generation;
+    header.encoded_size = encodeRows(
+        [&engine](const int y, Cell *row) { engine.copyRow(y, row); },
+        engine.getWidth(),
+        engine.getHeight(),
+        &buffer[sizeof(SnapshotHeader)]
+    );
+    std::memcpy(buffer, &header, sizeof(SnapshotHeader));
+
+    // The header goes first on its own, so the collector knows how many
+    // chunks of the strip follow
+    int status = MPI_Isend(
+        buffer,
+        sizeof(SnapshotHeader),
+        MPI_BYTE,
+        collector_id,
+        0,
+        MPI_COMM_WORLD,
+        &buffer_requests[0]
+    );
+    const int strip_status = isendChunked(
+        &buffer[sizeof(SnapshotHeader)],
+        header.encoded_size,
+        MPI_BYTE,
+        collector_id,
+        0,
+        &buffer_requests[1]
+    );
+    if (status == MPI_SUCCESS) {
+        status = strip_status;
+    }
+    if (status != MPI_SUCCESS) {
+        std::cerr << "Error in sending snapshot of generation " << generation
+                  << std::endl;
+    }
+    if (executor) {
+        executor->spawn(awaitSends(next_buffer));
+    }
+
+    next_buffer = (next_buffer + 1) % buffers_count;
+    return true;
+}
+
+void SnapshotSender::progress() {
+    // The executor progresses the sends whenever it runs
+    if (executor) {
+        return;
+    }
+    for (std::vector<MPI_Request> &buffer_requests : requests) {
+        int done;
+        MPI_Testall(
+            static_cast<int>(buffer_requests.size()),
+            buffer_requests.data(),
+            &done,
+            MPI_STATUSES_IGNORE
+        );
+    }
+}
+
+void SnapshotSender::flush() {
+    if (executor) {
+        executor->drain();
+        return;
+    }
+    for (std::vector<MPI_Request> &buffer_requests : requests) {
+        MPI_Waitall(
+            static_cast<int>(buffer_requests.size()),
+            buffer_requests.data(),
+            MPI_STATUSES_IGNORE
+        );
+    }
+}
+
+int SnapshotSender::getDroppedCount() const { return dropped_count; }
+
+bool SnapshotSender::isBufferFree(const int buffer) const {
+    return std::all_of(
+        requests[buffer].begin(),
+        requests[buffer].end(),
+        [](const MPI_Request request) { return request == MPI_REQUEST_NULL; }
+    );
+}
+
+Task SnapshotSender::awaitSends(const int buffer) {
+    co_await executor->wait(
+        requests[buffer].data(),
+        static_cast<int>(requests[buffer].size())
+    );
+}
+
+void collectSnapshots(
+    const int board_size,
+    const BoardInitType init_type,
+    const int *start_rows,
+    const int *num_rows,
+    const int workers_count,
+    const int iterations,
+    const std::string &output_directory
+) {
+    // Save first iteration
+    savePGM(initialPGM(board_size, init_type), output_directory, 0);
+
+    // Workers send nothing without generations to compute
+    if (iterations == 0) {
+        return;
+    }
+
+    // Frames being assembled: generation -> (pixels, received strips)
+    std::map<int, std::pair<uint8_t *, int>> frames;
+    // Header and encoded strip of every worker
+    std::vector<SnapshotHeader> headers(workers_count);
+    std::vector<std::vector<uint8_t>> staging(workers_count);
+    std::vector<size_t> cells_counts(workers_count);
+    // Whether the strip of the current message is being received
+    std::vector<bool> header_received(workers_count);
+    // Requests of worker i start at i * max_chunks, header first
+    int max_chunks = 0;
+    for (int i = 0; i < workers_count; ++i) {
+        cells_counts[i] = static_cast<size_t>(board_size) * num_rows[i];
+        staging[i].resize(maxEncodedSize(cells_counts[i]));
+        max_chunks = std::max(max_chunks, requestsCount(cells_counts[i]));
+    }
+    std::vector<MPI_Request> requests(
+        static_cast<size_t>(workers_count) * max_chunks,
+        MPI_REQUEST_NULL
+    );
+    std::vector<int> pending_chunks(workers_count);
+    // Last generation received from every worker
+    std::vector<int> last_generations(workers_count, 0);
+    int finished_workers = 0, saved_count = 0, dropped_count = 0;
+
+    // Posts the header of the next message of the worker
+    const auto receive = [&](const int worker) {
+        header_received[worker] = false;
+        pending_chunks[worker] = 1;
+        MPI_Irecv(
+            &headers[worker],
+            sizeof(SnapshotHeader),
+            MPI_BYTE,
+            worker,
+            0,
+            MPI_COMM_WORLD,
+            &requests[static_cast<size_t>(worker) * max_chunks]
+        );
+    };
+
+    for (int i = 0; i < workers_count; ++i) {
+        receive(i);
+    }
+
+    while (finished_workers < workers_count) {
+        int request_idx;
+        MPI_Waitany(
+            static_cast<int>(requests.size()),
+            requests.data(),
+            &request_idx,
+            MPI_STATUS_IGNORE
+        );
+        const int worker = request_idx / max_chunks;
+        if (!header_received[worker]) {
+            // The header tells how many chunks of the strip follow
+            header_received[worker] = true;
+            const size_t encoded_size = headers[worker].encoded_size;
+            pending_chunks[worker] += chunksCount(encoded_size);
+            irecvChunked(
+                staging[worker].data(),
+                encoded_size,
+                MPI_BYTE,
+                worker,
+                0,
+                &requests[static_cast<size_t>(worker) * max_chunks + 1]
+            );
+        }
+        if (--pending_chunks[worker] > 0) {
+            continue;
+        }
+
+        const int generation = headers[worker].generation;
+        last_generations[worker] = generation;
+
+        auto [frame, inserted] =
+            frames.try_emplace(generation, nullptr, 0);
+        if (inserted) {
+            frame->second.first =
+                new uint8_t[static_cast<size_t>(board_size) * board_size];
+        }
+        uint8_t *strip = &frame->second.first
+            [static_cast<size_t>(start_rows[worker]) * board_size];
+        decodeCells(
+            staging[worker].data(),
+            cells_counts[worker],
+            strip,
+            dead_pixel,
+            alive_pixel
+        );
+        if (worker > 0) {
+            std::replace(
+                strip,
+                &strip[board_size],
+                dead_pixel,
+                edge_dead_pixel
+            );
+        }
+
+        if (++frame->second.second == workers_count) {
+            // The PGM takes over the pixels
+            const PGM pgm(board_size, board_size, frame->second.first);
+            savePGM(pgm, output_directory, generation);
+            frames.erase(frame);
+            ++saved_count;
+        }
+
+        // Strips from a single worker arrive in order, so a frame older than
+        // the last generation of every worker can no longer be completed
+        const int oldest_generation =
+            *std::min_element(last_generations.begin(), last_generations.end());
+        while (!frames.empty() && frames.begin()->first < oldest_generation) {
+            delete[] frames.begin()->second.first;
+            frames.erase(frames.begin());
+            ++dropped_count;
+        }
+
+        if (generation == iterations) {
+            ++finished_workers;
+        } else {
+            receive(worker);
+        }
+    }
+
+    std::cout << saved_count << " snapshots saved, " << dropped_count
+              << " dropped" << std::endl;
+}
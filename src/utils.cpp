@@ -3,43 +3,196 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 void printParseArgumentsUsage(int argc, char* argv[]) {
     std::cout << "Usage: " << argv[0]
-              << " <size> <iterations> <type> <output_directory>\n"
+              << " <size> <iterations> <type> [output_directory] [options]\n"
               << "  type: type of the initial board\n"
               << "    0: line\n"
               << "    1: t shape\n"
               << "    2: cross\n"
-              << "  output_directory: directory to save the output (verbose)\n";
+              << "  output_directory: directory to save the output (verbose)\n"
+              << "Options:\n"
+              << "  --interval=N: save every N-th generation (default 1)\n"
+              << "  --policy=drop|block: what to do with a snapshot when the\n"
+              << "    collector falls behind (default block)\n"
+              << "  --engine=scalar|vectorized|bitpacked|sparse|tiled:\n"
+              << "    stepping backend (default scalar)\n"
+              << "  --exchange=none|blocking|overlapped|coroutine: edge rows\n"
+              << "    exchange strategy (default depends on the solution)\n"
+              << "  --hash: print hash of the board after every saved\n"
+              << "    generation, see --interval\n"
+              << "  --huge-pages: back the board with transparent huge pages\n"
+              << "  --numa-report: print NUMA placement of the board rows\n"
+              << "  --out-of-core=DIR: keep the board in memory-mapped files\n"
+              << "    in DIR, single process with exchange none only\n"
+              << "  --out-of-core-band=BYTES: size of a band buffer of the\n"
+              << "    out-of-core board (default 64 MiB)\n"
+              << "  --max-message=N: split snapshot messages into chunks of\n"
+              << "    at most N elements (default 2^30)\n";
+}
+
+// Parses a single "--name=value" or "--name" option, returns 1 on unknown
+// option or value
+int parseOption(const std::string& option, Args* args) {
+    const size_t separator = option.find('=');
+    const std::string name = option.substr(2, separator - 2);
+    const std::string value =
+        separator == std::string::npos ? "" : option.substr(separator + 1);
+
+    if (name == "hash") {
+        args->print_hashes = true;
+        return value.empty() ? 0 : 1;
+    }
+    if (name == "huge-pages") {
+        args->huge_pages = true;
+        return value.empty() ? 0 : 1;
+    }
+    if (name == "numa-report") {
+        args->print_numa_report = true;
+        return value.empty() ? 0 : 1;
+    }
+    if (name == "out-of-core") {
+        args->out_of_core_directory = value;
+        return value.empty() ? 1 : 0;
+    }
+    if (name == "out-of-core-band") {
+        args->out_of_core_band_bytes = atol(value.c_str());
+        return args->out_of_core_band_bytes > 0 ? 0 : 1;
+    }
+    if (name == "max-message") {
+        args->max_message_count = atol(value.c_str());
+        return args->max_message_count > 0 ? 0 : 1;
+    }
+    if (name == "interval") {
+        args->snapshot_interval = atoi(value.c_str());
+        return args->snapshot_interval > 0 ? 0 : 1;
+    }
+    if (name == "policy") {
+        if (value == "block") {
+            args->snapshot_policy = BLOCK;
+        } else if (value == "drop") {
+            args->snapshot_policy = DROP;
+        } else {
+            return 1;
+        }
+        return 0;
+    }
+    if (name == "engine") {
+        if (value == "scalar") {
+            args->engine_type = SCALAR;
+        } else if (value == "vectorized") {
+            args->engine_type = VECTORIZED;
+        } else if (value == "bitpacked") {
+            args->engine_type = BITPACKED;
+        } else if (value == "sparse") {
+            args->engine_type = SPARSE;
+        } else if (value == "tiled") {
+            args->engine_type = TILED;
+        } else {
+            return 1;
+        }
+        return 0;
+    }
+    if (name == "exchange") {
+        if (value == "none") {
+            args->exchange_type = NONE;
+        } else if (value == "blocking") {
+            args->exchange_type = BLOCKING;
+        } else if (value == "overlapped") {
+            args->exchange_type = OVERLAPPED;
+        } else if (value == "coroutine") {
+            args->exchange_type = COROUTINE;
+        } else {
+            return 1;
+        }
+        return 0;
+    }
+    return 1;
 }
 
 // Function to parse command-line arguments
 int parseArguments(const int argc, char* argv[], Args* args) {
-    if (argc < 3) {
+    std::vector<char*> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            positional.push_back(argv[i]);
+            continue;
+        }
+        if (parseOption(arg, args) == 1) {
+            std::cerr << "Invalid option: " << arg << std::endl;
+            printParseArgumentsUsage(argc, argv);
+            return 1;
+        }
+    }
+
+    if (positional.size() < 3) {
         printParseArgumentsUsage(argc, argv);
         return 1;
     }
 
-    args->board_size = atoi(argv[1]);
-    args->iterations = atoi(argv[2]);
-    args->init_type = static_cast<BoardInitType>(atoi(argv[3]));
+    args->board_size = atoi(positional[0]);
+    args->iterations = atoi(positional[1]);
+    args->init_type = static_cast<BoardInitType>(atoi(positional[2]));
 
-    if (argc > 4) {
-        args->output_directory = argv[4];
+    if (positional.size() > 3) {
+        args->output_directory = positional[3];
         args->is_verbose = true;
     }
 
     return 0;
 }
 
+void partitionRows(
+    const int rows_count,
+    const int procs_count,
+    int* start_rows,
+    int* num_rows
+) {
+    int row = 0;
+    for (int p_id = 0; p_id < procs_count; ++p_id) {
+        const int rows_for_proc = (rows_count / procs_count) +
+                                  (p_id < rows_count % procs_count ? 1 : 0);
+        start_rows[p_id] = row;
+        num_rows[p_id] = rows_for_proc;
+        row += rows_for_proc;
+    }
+}
+
+uint64_t hashCells(
+    const Cell* cells,
+    const size_t count,
+    const size_t first_index
+) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (cells[i] != ALIVE) {
+            continue;
+        }
+        // splitmix64 of the cell index
+        uint64_t z = first_index + i + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        hash += z ^ (z >> 31);
+    }
+    return hash;
+}
+
+bool isSnapshotGeneration(const Args& args, const int generation) {
+    return generation % args.snapshot_interval == 0 ||
+           generation == args.iterations;
+}
+
 PGM PGMFromBoard(const Board& board) {
     const int width = board.getWidth();
     const int height = board.getHeight();
     const Cell* board_data = board.getBoard();
-    PGM pgm{width, height, new u_int8_t[width * height]};
+    const size_t size = board.getSize();
+    PGM pgm{width, height, new u_int8_t[size]};
 
-    for (int i = 0; i < width * height; ++i) {
+    for (size_t i = 0; i < size; ++i) {
         pgm.data[i] = board_data[i] == ALIVE ? 255 : 0;
     }
 
@@ -53,7 +206,7 @@ PGM PGMFromCells(
     const int* edge_rows,
     const int edge_row_count
 ) {
-    PGM pgm{width, height, new u_int8_t[width * height]};
+    PGM pgm{width, height, new u_int8_t[static_cast<size_t>(width) * height]};
     int edge_idx = 0;
 
     for (int row = 0; row < height; ++row) {
@@ -61,7 +214,7 @@ PGM PGMFromCells(
             (edge_idx < edge_row_count && edge_rows[edge_idx] == row);
 
         for (int col = 0; col < width; ++col) {
-            const int idx = row * width + col;
+            const size_t idx = static_cast<size_t>(row) * width + col;
             if (is_edge_row) {
                 pgm.data[idx] = cells[idx] == ALIVE ? 255 : 69;
             } else {
@@ -102,7 +255,7 @@ void savePGM(
     // Data
     outfile.write(
         reinterpret_cast<const char*>(pgm.data),
-        pgm.width * pgm.height
+        static_cast<std::streamsize>(pgm.width) * pgm.height
     );
     outfile.close();
 }
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "../include/wire.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+size_t bitsSize(const size_t count) { return (count + 7) / 8; }
+
+size_t varintSize(size_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+uint8_t *writeVarint(size_t value, uint8_t *out) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+const uint8_t *readVarint(const uint8_t *data, size_t &value) {
+    value = 0;
+    int shift = 0;
+    while (*data & 0x80) {
+        value |= static_cast<size_t>(*data++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= static_cast<size_t>(*data++) << shift;
+    return data;
+}
+
+// Runs of cells handed over in parts, e.g. rows of a strip
+struct Runs {
+    // Cells handed over so far
+    size_t position = 0;
+    size_t run_start = 0;
+    Cell value = DEAD;
+    // Bytes of the runs that ended
+    size_t size = 0;
+};
+
+// Adds the cells to the size of the runs. Returns false once the size
+// reaches the limit, so dense rows are given up on early.
+bool addRunsSize(
+    Runs &runs,
+    const Cell *cells,
+    const size_t count,
+    const size_t limit
+) {
+    for (size_t i = 0; i < count; ++i) {
+        if (cells[i] != runs.value) {
+            const size_t position = runs.position + i;
+            runs.size += varintSize(position - runs.run_start);
+            if (runs.size >= limit) {
+                return false;
+            }
+            runs.run_start = position;
+            runs.value = cells[i];
+        }
+    }
+    runs.position += count;
+    return true;
+}
+
+// Size of the runs encoding including the last run, or limit once it
+// reaches the limit
+size_t finishRunsSize(const Runs &runs, const size_t limit) {
+    return std::min(
+        limit,
+        runs.size + varintSize(runs.position - runs.run_start)
+    );
+}
+
+void encodeBits(const Cell *cells, const size_t count, uint8_t *out) {
+    const size_t full_bytes = count / 8;
+#pragma omp simd
+    for (size_t i = 0; i < full_bytes; ++i) {
+        const Cell *group = &cells[i * 8];
+        uint8_t byte = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            byte |= static_cast<uint8_t>(group[bit] == ALIVE) << bit;
+        }
+        out[i] = byte;
+    }
+    if (count % 8 != 0) {
+        uint8_t byte = 0;
+        for (size_t i = full_bytes * 8; i < count; ++i) {
+            byte |= static_cast<uint8_t>(cells[i] == ALIVE) << (i % 8);
+        }
+        out[full_bytes] = byte;
+    }
+}
+
+template <typename Value>
+void decodeBits(
+    const uint8_t *bits,
+    const size_t count,
+    Value *out,
+    const Value dead,
+    const Value alive
+) {
+#pragma omp simd
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = (bits[i / 8] >> (i % 8)) & 1 ? alive : dead;
+    }
+}
+
+// Bits of the cells, the first of them at cell position of the output. A
+// byte is written whole with its first cell, later cells are or-ed in.
+void appendBits(
+    const Cell *cells,
+    const size_t count,
+    const size_t position,
+    uint8_t *out
+) {
+    size_t i = 0;
+    for (; i < count && (position + i) % 8 != 0; ++i) {
+        out[(position + i) / 8] |= static_cast<uint8_t>(cells[i] == ALIVE)
+                                   << ((position + i) % 8);
+    }
+    encodeBits(&cells[i], count - i, &out[(position + i) / 8]);
+}
+
+// Writes the runs that end within the cells, returns the end of the output
+uint8_t *appendRuns(
+    Runs &runs,
+    const Cell *cells,
+    const size_t count,
+    uint8_t *out
+) {
+    for (size_t i = 0; i < count; ++i) {
+        if (cells[i] != runs.value) {
+            const size_t position = runs.position + i;
+            out = writeVarint(position - runs.run_start, out);
+            runs.run_start = position;
+            runs.value = cells[i];
+        }
+    }
+    runs.position += count;
+    return out;
+}
+
+// Writes the last run
+void finishRuns(const Runs &runs, uint8_t *out) {
+    writeVarint(runs.position - runs.run_start, out);
+}
+
+template <typename Value>
+void decodeRuns(
+    const uint8_t *data,
+    const size_t count,
+    Value *out,
+    const Value dead,
+    const Value alive
+) {
+    size_t position = 0;
+    bool is_alive = false;
+    while (position < count) {
+        size_t length;
+        data = readVarint(data, length);
+        std::fill_n(&out[position], length, is_alive ? alive : dead);
+        position += length;
+        is_alive = !is_alive;
+    }
+}
+
+template <typename Value>
+void decodeValues(
+    const uint8_t *data,
+    const size_t count,
+    Value *out,
+    const Value dead,
+    const Value alive
+) {
+    if (data[0] == WIRE_RUNS) {
+        decodeRuns(&data[1], count, out, dead, alive);
+    } else {
+        decodeBits(&data[1], count, out, dead, alive);
+    }
+}
+}  // namespace
+
+size_t maxEncodedSize(const size_t count) { return 1 + bitsSize(count); }
+
+size_t encodeCells(const Cell *cells, const size_t count, uint8_t *out) {
+    const size_t bits_size = bitsSize(count);
+    Runs measured;
+    addRunsSize(measured, cells, count, bits_size);
+    const size_t runs_size = finishRunsSize(measured, bits_size);
+    if (runs_size < bits_size) {
+        out[0] = WIRE_RUNS;
+        Runs runs;
+        finishRuns(runs, appendRuns(runs, cells, count, &out[1]));
+        return 1 + runs_size;
+    }
+    out[0] = WIRE_BITS;
+    encodeBits(cells, count, &out[1]);
+    return 1 + bits_size;
+}
+
+size_t encodeRows(
+    const std::function<void(int, Cell *)> &copy_row,
+    const int width,
+    const int height,
+    uint8_t *out
+) {
+    const size_t count = static_cast<size_t>(width) * height;
+    const size_t bits_size = bitsSize(count);
+    std::vector<Cell> row(width);
+
+    Runs measured;
+    bool is_sparse = true;
+    for (int y = 0; y < height && is_sparse; ++y) {
+        copy_row(y, row.data());
+        is_sparse = addRunsSize(measured, row.data(), width, bits_size);
+    }
+    const size_t runs_size =
+        is_sparse ? finishRunsSize(measured, bits_size) : bits_size;
+
+    if (runs_size < bits_size) {
+        out[0] = WIRE_RUNS;
+        Runs runs;
+        uint8_t *end = &out[1];
+        for (int y = 0; y < height; ++y) {
+            copy_row(y, row.data());
+            end = appendRuns(runs, row.data(), width, end);
+        }
+        finishRuns(runs, end);
+        return 1 + runs_size;
+    }
+    out[0] = WIRE_BITS;
+    for (int y = 0; y < height; ++y) {
+        copy_row(y, row.data());
+        appendBits(
+            row.data(),
+            width,
+            static_cast<size_t>(y) * width,
+            &out[1]
+        );
+    }
+    return 1 + bits_size;
+}
+
+void decodeCells(const uint8_t *data, const size_t count, Cell *out) {
+    decodeValues(data, count, out, DEAD, ALIVE);
+}
+
+void decodeCells(
+    const uint8_t *data,
+    const size_t count,
+    uint8_t *out,
+    const uint8_t dead,
+    const uint8_t alive
+) {
+    decodeValues(data, count, out, dead, alive);
+}
@@ -0,0 +1,72 @@
+// Compares two snapshots saved as PGM by the solutions cell by cell. Alive
+// cells are white, dead ones black, or gray on the first rows of the strips
+// of a multi-process run, so only whether a cell is alive is compared.
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr uint8_t ALIVE_VALUE = 255;
+
+struct Snapshot {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> data;
+};
+
+bool readSnapshot(const std::string &path, Snapshot &snapshot) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int max_value = 0;
+    file >> magic >> snapshot.width >> snapshot.height >> max_value;
+    // Single whitespace between the header and the data
+    file.get();
+    if (!file || magic != "P5" || max_value != 255) {
+        std::cerr << path << ": not a snapshot" << std::endl;
+        return false;
+    }
+
+    snapshot.data.resize(static_cast<size_t>(snapshot.width) * snapshot.height);
+    file.read(
+        reinterpret_cast<char *>(snapshot.data.data()),
+        static_cast<std::streamsize>(snapshot.data.size())
+    );
+    if (!file) {
+        std::cerr << path << ": truncated snapshot" << std::endl;
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+int main(const int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <expected> <actual>\n";
+        return 1;
+    }
+    Snapshot expected, actual;
+    if (!readSnapshot(argv[1], expected) || !readSnapshot(argv[2], actual)) {
+        return 1;
+    }
+    if (expected.width != actual.width || expected.height != actual.height) {
+        std::cerr << "Expected " << expected.width << "x" << expected.height
+                  << " board, got " << actual.width << "x" << actual.height
+                  << std::endl;
+        return 1;
+    }
+
+    for (size_t i = 0; i < expected.data.size(); ++i) {
+        const bool expected_alive = expected.data[i] == ALIVE_VALUE;
+        const bool actual_alive = actual.data[i] == ALIVE_VALUE;
+        if (expected_alive != actual_alive) {
+            std::cerr << "Cell mismatch at row " << i / expected.width
+                      << ", column " << i % expected.width << ": expected "
+                      << (expected_alive ? "alive" : "dead") << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Trusted reference for the golden tests: a deliberately naive Game of Life
+// that shares no code with the solutions. Prints the same "hash" lines as
+// the solutions run with --hash.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+uint64_t hashCell(const uint64_t index) {
+    uint64_t z = index + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t hashBoard(const std::vector<std::vector<bool>> &board) {
+    const size_t size = board.size();
+    uint64_t hash = 0;
+    for (size_t y = 0; y < size; ++y) {
+        for (size_t x = 0; x < size; ++x) {
+            if (board[y][x]) {
+                hash += hashCell(y * size + x);
+            }
+        }
+    }
+    return hash;
+}
+}  // namespace
+
+int main(const int argc, char *argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <size> <iterations> <type>\n";
+        return 1;
+    }
+    const int size = atoi(argv[1]);
+    const int iterations = atoi(argv[2]);
+    const int type = atoi(argv[3]);
+
+    // Same initial patterns as Board::Init
+    std::vector<std::vector<bool>> board(size, std::vector<bool>(size));
+    for (int i = 0; i < size; ++i) {
+        board[i][size / 2] = true;
+        if (type == 1) {
+            board[0][i] = true;
+        }
+        if (type == 2) {
+            board[size / 2][i] = true;
+        }
+    }
+
+    std::cout << "hash 0 " << std::hex << hashBoard(board) << std::dec << "\n";
+    for (int generation = 1; generation <= iterations; ++generation) {
+        std::vector<std::vector<bool>> next(size, std::vector<bool>(size));
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                int neighbors = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int ny = y + dy, nx = x + dx;
+                        if ((dy != 0 || dx != 0) && ny >= 0 && ny < size &&
+                            nx >= 0 && nx < size && board[ny][nx]) {
+                            ++neighbors;
+                        }
+                    }
+                }
+                next[y][x] = neighbors == 3 || (board[y][x] && neighbors == 2);
+            }
+        }
+        board.swap(next);
+        std::cout << "hash " << generation << " " << std::hex
+                  << hashBoard(board) << std::dec << "\n";
+    }
+    return 0;
+}
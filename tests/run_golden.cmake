@@ -0,0 +1,123 @@
+# Runs the solution and the reference on every size and type of the matrix
+# and compares the board hashes of every generation.
+#
+# Option --verbose is replaced by the output directory argument. The saved
+# snapshots are then compared with the ones of a single process run, which
+# saves them itself. With --interval=N only hashes of every N-th and the last
+# generation are compared.
+
+cmake_minimum_required(VERSION 3.22)
+
+string(REPLACE "," ";" MPIEXEC_FLAGS "${MPIEXEC_FLAGS}")
+string(REPLACE "," ";" SINGLE_MPIEXEC_FLAGS "${SINGLE_MPIEXEC_FLAGS}")
+string(REPLACE "," ";" OPTIONS "${OPTIONS}")
+string(REPLACE "," ";" SIZES "${SIZES}")
+string(REPLACE "," ";" TYPES "${TYPES}")
+
+set(positional "")
+set(single_directory ${OUTPUT_DIRECTORY}_single)
+if ("--verbose" IN_LIST OPTIONS)
+    list(REMOVE_ITEM OPTIONS --verbose)
+    set(positional ${OUTPUT_DIRECTORY})
+endif ()
+
+set(interval 1)
+foreach (option IN LISTS OPTIONS)
+    if (option MATCHES "^--interval=([0-9]+)$")
+        set(interval ${CMAKE_MATCH_1})
+    endif ()
+endforeach ()
+
+foreach (size IN LISTS SIZES)
+    foreach (type IN LISTS TYPES)
+        set(run "size ${size}, type ${type}, ${ITERATIONS} iterations")
+        # Snapshots of the previous run must not be compared
+        file(REMOVE_RECURSE ${OUTPUT_DIRECTORY} ${single_directory})
+
+        execute_process(
+                COMMAND ${REFERENCE} ${size} ${ITERATIONS} ${type}
+                OUTPUT_VARIABLE expected_output
+                RESULT_VARIABLE result)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Reference failed (${run}): ${result}")
+        endif ()
+
+        execute_process(
+                COMMAND ${MPIEXEC} ${MPIEXEC_FLAGS} ${SOLUTION}
+                ${size} ${ITERATIONS} ${type} ${positional} ${OPTIONS} --hash
+                OUTPUT_VARIABLE output
+                ERROR_VARIABLE errors
+                RESULT_VARIABLE result
+                TIMEOUT 300)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Solution failed (${run}): ${result}\n"
+                    "${output}\n${errors}")
+        endif ()
+
+        string(REGEX MATCHALL "hash [0-9]+ [0-9a-f]+" all_expected
+                "${expected_output}")
+        set(expected "")
+        foreach (line IN LISTS all_expected)
+            string(REGEX REPLACE "^hash ([0-9]+) .*$" "\\1" generation
+                    "${line}")
+            math(EXPR remainder "${generation} % ${interval}")
+            if (remainder EQUAL 0 OR generation EQUAL ITERATIONS)
+                list(APPEND expected "${line}")
+            endif ()
+        endforeach ()
+        string(REGEX MATCHALL "hash [0-9]+ [0-9a-f]+" actual "${output}")
+
+        list(LENGTH expected expected_count)
+        list(LENGTH actual actual_count)
+        if (NOT actual_count EQUAL expected_count)
+            message(FATAL_ERROR "Expected ${expected_count} hashes, got "
+                    "${actual_count} (${run})\n${output}\n${errors}")
+        endif ()
+
+        foreach (expected_hash actual_hash IN ZIP_LISTS expected actual)
+            if (NOT expected_hash STREQUAL actual_hash)
+                message(FATAL_ERROR "Board mismatch (${run}): expected "
+                        "'${expected_hash}', got '${actual_hash}'")
+            endif ()
+        endforeach ()
+
+        if (NOT positional)
+            continue()
+        endif ()
+
+        execute_process(
+                COMMAND ${MPIEXEC} ${SINGLE_MPIEXEC_FLAGS} ${SOLUTION}
+                ${size} ${ITERATIONS} ${type} ${single_directory} ${OPTIONS}
+                OUTPUT_VARIABLE output
+                ERROR_VARIABLE errors
+                RESULT_VARIABLE result
+                TIMEOUT 300)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Single process run failed (${run}): "
+                    "${result}\n${output}\n${errors}")
+        endif ()
+
+        # Snapshots may be dropped, but never the first and the last one
+        file(GLOB snapshots RELATIVE ${OUTPUT_DIRECTORY}
+                ${OUTPUT_DIRECTORY}/snapshot_*.pgm)
+        foreach (generation 0 ${ITERATIONS})
+            if (NOT "snapshot_${generation}.pgm" IN_LIST snapshots)
+                message(FATAL_ERROR "Snapshot of generation ${generation} "
+                        "not saved (${run})")
+            endif ()
+        endforeach ()
+
+        foreach (snapshot IN LISTS snapshots)
+            execute_process(
+                    COMMAND ${COMPARE_SNAPSHOTS}
+                    ${single_directory}/${snapshot}
+                    ${OUTPUT_DIRECTORY}/${snapshot}
+                    ERROR_VARIABLE errors
+                    RESULT_VARIABLE result)
+            if (NOT result EQUAL 0)
+                message(FATAL_ERROR "Snapshot mismatch (${run}, "
+                        "${snapshot}): ${errors}")
+            endif ()
+        endforeach ()
+    endforeach ()
+endforeach ()
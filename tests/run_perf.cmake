@@ -0,0 +1,50 @@
+# Runs the solution a few times and fails if the best throughput is more than
+# THRESHOLD percent below the baseline recorded for NAME and BUILD_TYPE.
+#
+# Baselines file lines: <build type> <name> <cell updates per second>
+
+cmake_minimum_required(VERSION 3.22)
+
+string(REPLACE "," ";" MPIEXEC_FLAGS "${MPIEXEC_FLAGS}")
+string(REPLACE "," ";" OPTIONS "${OPTIONS}")
+
+set(SIZE 1024)
+set(ITERATIONS 50)
+set(TYPE 2)
+set(RUNS 3)
+
+file(STRINGS ${BASELINES} lines REGEX "^${BUILD_TYPE} ${NAME} ")
+if (NOT lines)
+    message("No baseline for ${BUILD_TYPE} ${NAME} in ${BASELINES}")
+    return()
+endif ()
+list(GET lines 0 line)
+string(REGEX REPLACE "^.* ([0-9]+)$" "\\1" baseline "${line}")
+
+set(best 0)
+foreach (run RANGE 1 ${RUNS})
+    execute_process(
+            COMMAND ${MPIEXEC} ${MPIEXEC_FLAGS} ${SOLUTION}
+            ${SIZE} ${ITERATIONS} ${TYPE} ${OPTIONS}
+            OUTPUT_VARIABLE output
+            ERROR_VARIABLE errors
+            RESULT_VARIABLE result
+            TIMEOUT 300)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Solution failed: ${result}\n${output}\n${errors}")
+    endif ()
+
+    if (NOT output MATCHES "([0-9]+) - cell updates per second")
+        message(FATAL_ERROR "No throughput in the output:\n${output}")
+    endif ()
+    if (CMAKE_MATCH_1 GREATER best)
+        set(best ${CMAKE_MATCH_1})
+    endif ()
+endforeach ()
+
+math(EXPR minimum "${baseline} / 100 * (100 - ${THRESHOLD})")
+message("${BUILD_TYPE} ${NAME} ${best} (baseline ${baseline}, "
+        "minimum ${minimum})")
+if (best LESS minimum)
+    message(FATAL_ERROR "Throughput regression: ${best} < ${minimum}")
+endif ()
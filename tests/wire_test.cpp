@@ -0,0 +1,149 @@
+// Round trip of encodeCells and decodeCells, to cells and to pixels, on rows
+// picking either format, including partial bytes of bits and runs needing
+// multi-byte varints. encodeRows must give the same bytes as encodeCells.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/wire.hpp"
+
+namespace {
+// Cells made of alternating runs of the given lengths, starting with a dead
+// one
+std::vector<Cell> runs(const std::vector<size_t> &lengths) {
+    std::vector<Cell> cells;
+    Cell value = DEAD;
+    for (const size_t length : lengths) {
+        cells.insert(cells.end(), length, value);
+        value = value == DEAD ? ALIVE : DEAD;
+    }
+    return cells;
+}
+
+std::vector<Cell> alternating(const size_t count) {
+    std::vector<Cell> cells(count);
+    for (size_t i = 0; i < count; ++i) {
+        cells[i] = i % 2 == 0 ? ALIVE : DEAD;
+    }
+    return cells;
+}
+
+// Returns false and reports the case if the cells do not survive the round
+// trip in the expected format
+bool checkRoundTrip(
+    const std::string &name,
+    const std::vector<Cell> &cells,
+    const WireFormat expected_format
+) {
+    const size_t count = cells.size();
+    std::vector<uint8_t> encoded(maxEncodedSize(count));
+    const size_t encoded_size =
+        encodeCells(cells.data(), count, encoded.data());
+    if (encoded_size > encoded.size()) {
+        std::cerr << name << ": encoded " << encoded_size << " bytes, at most "
+                  << encoded.size() << " expected" << std::endl;
+        return false;
+    }
+    if (encoded[0] != expected_format) {
+        std::cerr << name << ": format " << static_cast<int>(encoded[0])
+                  << ", " << static_cast<int>(expected_format) << " expected"
+                  << std::endl;
+        return false;
+    }
+
+    // Rows of the cells encode to the same bytes, also when rows end within
+    // a byte of bits
+    for (const size_t width : {1, 3, 8, 13, 128}) {
+        if (count % width != 0) {
+            continue;
+        }
+        std::vector<uint8_t> rows_encoded(maxEncodedSize(count));
+        const size_t rows_size = encodeRows(
+            [&](const int y, Cell *row) {
+                std::copy_n(&cells[y * width], width, row);
+            },
+            static_cast<int>(width),
+            static_cast<int>(count / width),
+            rows_encoded.data()
+        );
+        if (rows_size != encoded_size ||
+            !std::equal(
+                encoded.begin(),
+                encoded.begin() + encoded_size,
+                rows_encoded.begin()
+            )) {
+            std::cerr << name << ": rows of " << width
+                      << " cells encoded differently" << std::endl;
+            return false;
+        }
+    }
+
+    // Only the encoded bytes reach the receiver
+    encoded.resize(encoded_size);
+    std::vector<Cell> decoded(count, ALIVE);
+    decodeCells(encoded.data(), count, decoded.data());
+    for (size_t i = 0; i < count; ++i) {
+        if (decoded[i] != cells[i]) {
+            std::cerr << name << ": cell " << i << " decoded as "
+                      << decoded[i] << ", " << cells[i] << " expected"
+                      << std::endl;
+            return false;
+        }
+    }
+
+    // Pixels of the collector
+    std::vector<uint8_t> pixels(count, 1);
+    decodeCells(encoded.data(), count, pixels.data(), 0, 255);
+    for (size_t i = 0; i < count; ++i) {
+        if (pixels[i] != (cells[i] == ALIVE ? 255 : 0)) {
+            std::cerr << name << ": pixel " << i << " decoded as "
+                      << static_cast<int>(pixels[i]) << ", cell "
+                      << cells[i] << " expected" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main() {
+    bool passed = true;
+
+    // Counts not divisible by 8 leave a partial last byte of bits
+    passed &= checkRoundTrip("alternating 8", alternating(8), WIRE_BITS);
+    passed &= checkRoundTrip("alternating 13", alternating(13), WIRE_BITS);
+    passed &= checkRoundTrip("alternating 1001", alternating(1001), WIRE_BITS);
+    passed &= checkRoundTrip("alternating 520", alternating(520), WIRE_BITS);
+    // Runs look shorter until the dense rows at the end
+    std::vector<Cell> mixed = runs({3899, 1});
+    const std::vector<Cell> dense = alternating(3900);
+    mixed.insert(mixed.end(), dense.begin(), dense.end());
+    passed &= checkRoundTrip("sparse then dense", mixed, WIRE_BITS);
+    passed &= checkRoundTrip("single alive", {ALIVE}, WIRE_BITS);
+    passed &= checkRoundTrip("single dead", {DEAD}, WIRE_BITS);
+
+    // Uniform rows are a single run, or an empty dead run and an alive one
+    passed &= checkRoundTrip("all dead 17", runs({17}), WIRE_RUNS);
+    passed &= checkRoundTrip("all dead 20000", runs({20000}), WIRE_RUNS);
+    passed &= checkRoundTrip("all alive 17", runs({0, 17}), WIRE_RUNS);
+    passed &= checkRoundTrip("all alive 20000", runs({0, 20000}), WIRE_RUNS);
+
+    // Runs from 128 cells on take two or more varint bytes
+    passed &= checkRoundTrip("run 127", runs({127, 1, 127}), WIRE_RUNS);
+    passed &= checkRoundTrip("run 128", runs({128, 1, 128}), WIRE_RUNS);
+    passed &= checkRoundTrip(
+        "long runs",
+        runs({300, 129, 5, 16384, 1, 1000, 7}),
+        WIRE_RUNS
+    );
+    passed &= checkRoundTrip(
+        "long runs starting alive",
+        runs({0, 200, 131, 3, 70000}),
+        WIRE_RUNS
+    );
+
+    return passed ? 0 : 1;
+}